@@ -0,0 +1,116 @@
+#include "TelemetryDecoder.hpp"
+
+#include <new>
+
+namespace telemetry
+{
+
+  Reader::Reader(const Frame &frame) : offset_(TELEMETRY_HEADER)
+  {
+    bytes_.reserve(TELEMETRY_HEADER + frame.fields.size());
+    bytes_.push_back(frame.type);
+    bytes_.push_back(frame.sequence);
+    bytes_.insert(bytes_.end(), frame.fields.begin(), frame.fields.end());
+  }
+
+  bool Reader::next(std::uint32_t &value)
+  {
+    uint32_t field = 0;
+
+    if (Telemetry_ReadUnsigned(bytes_.data(), bytes_.size(), &offset_, &field) != Success)
+      return false;
+
+    value = field;
+    return true;
+  }
+
+  bool Reader::next(std::int32_t &value)
+  {
+    sint32_t field = 0;
+
+    if (Telemetry_ReadSigned(bytes_.data(), bytes_.size(), &offset_, &field) != Success)
+      return false;
+
+    value = field;
+    return true;
+  }
+
+  bool Reader::atEnd() const
+  {
+    return offset_ >= bytes_.size();
+  }
+
+  Decoder::Decoder()
+  {
+    Telemetry_Decoder_Init(&state_);
+  }
+
+  std::vector<Frame> Decoder::feed(const std::uint8_t *data, std::size_t len)
+  {
+    std::vector<Frame> frames;
+
+    feed(data, len, [&frames](const Frame &frame)
+         { frames.push_back(frame); });
+
+    return frames;
+  }
+
+  Frame Decoder::frame() const
+  {
+    return Frame{state_.frame[0], state_.frame[1],
+                 std::vector<std::uint8_t>(state_.frame + TELEMETRY_HEADER, state_.frame + state_.len)};
+  }
+
+  const Telemetry_Decoder_DS &Decoder::state() const
+  {
+    return state_;
+  }
+
+  std::uint32_t Decoder::frames() const
+  {
+    return state_.frames;
+  }
+
+  std::uint32_t Decoder::lost() const
+  {
+    return state_.lost;
+  }
+
+  std::uint32_t Decoder::corrupted() const
+  {
+    return state_.corrupted;
+  }
+
+  Stream::Stream(std::size_t channels, std::uint16_t interval)
+      : state_(Telemetry_Stream_Constructor(channels, interval)), skipped_(0)
+  {
+    if (state_ == nullptr)
+      throw std::bad_alloc();
+  }
+
+  Stream::~Stream()
+  {
+    Telemetry_Stream_Destructor(state_);
+  }
+
+  bool Stream::decode(const Decoder &decoder, std::vector<std::int32_t> &values)
+  {
+    std::vector<sint32_t> fields(state_->channels);
+    size_t offset = TELEMETRY_HEADER;
+
+    if (Telemetry_Stream_Decode(state_, &decoder.state(), &offset, fields.data()) != Success)
+    {
+      skipped_++;
+      return false;
+    }
+
+    values.assign(fields.begin(), fields.end());
+    return true;
+  }
+
+  std::uint32_t Stream::skipped() const
+  {
+    return skipped_;
+  }
+
+} // namespace telemetry
@@ -0,0 +1,113 @@
+/**
+ * @file TelemetryDecoder.hpp
+ * @author Zhang, Zhen Yu (https://github.com/TooLateToDieYoung)
+ * @brief
+ * | Host side decoder of the telemetry frames sent by the firmware. \n
+ * | The C decoder of the library (Telemetry.c) does the work, \n
+ * | the same source as on the device, built with HOST_TOOLS.
+ * @version 0.1
+ * @date 2023-01-22
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef _TELEMETRY_DECODER_HPP_
+#define _TELEMETRY_DECODER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Telemetry.h"
+
+namespace telemetry
+{
+
+  /**
+   * @brief one good frame, CRC checked & removed
+   *
+   */
+  struct Frame
+  {
+    std::uint8_t type;
+    std::uint8_t sequence;
+    std::vector<std::uint8_t> fields; // * varints, read them with Reader
+  };
+
+  /**
+   * @brief reads the fields of a frame in order, the schema is known by the type
+   *
+   */
+  class Reader
+  {
+  public:
+    explicit Reader(const Frame &frame);
+
+    bool next(std::uint32_t &value); // * unsigned field, false at the end or on a broken varint
+    bool next(std::int32_t &value);  // * signed field (zig-zag)
+    bool atEnd() const;
+
+  private:
+    std::vector<std::uint8_t> bytes_; // * type, sequence & fields, as the C reader expects
+    std::size_t offset_;
+  };
+
+  /**
+   * @brief splits a byte stream into frames, counts the lost & corrupted ones
+   *
+   */
+  class Decoder
+  {
+  public:
+    Decoder();
+
+    // * each frame is handed to onFrame before the next byte is taken, streams need the live state
+    template <typename Callback>
+    void feed(const std::uint8_t *data, std::size_t len, Callback onFrame)
+    {
+      for (std::size_t i = 0; i < len; ++i)
+        if (Telemetry_Decode(&state_, data[i]) == Success)
+          onFrame(frame());
+    }
+
+    std::vector<Frame> feed(const std::uint8_t *data, std::size_t len);
+
+    std::uint32_t frames() const;    // * good frames
+    std::uint32_t lost() const;      // * frames missing by sequence
+    std::uint32_t corrupted() const; // * frames dropped by CRC, length or COBS
+
+    const Telemetry_Decoder_DS &state() const; // * the last good frame & the counters
+
+  private:
+    Frame frame() const;
+
+    Telemetry_Decoder_DS state_;
+  };
+
+  /**
+   * @brief restores the values of a delta stream, refer to Telemetry_Stream_DS
+   *
+   */
+  class Stream
+  {
+  public:
+    Stream(std::size_t channels, std::uint16_t interval);
+    ~Stream();
+
+    Stream(const Stream &) = delete;
+    Stream &operator=(const Stream &) = delete;
+
+    // * false: broken, or a delta while out of sync (until the next keyframe)
+    bool decode(const Decoder &decoder, std::vector<std::int32_t> &values);
+
+    std::uint32_t skipped() const; // * frames of the stream waiting for a keyframe
+
+  private:
+    Telemetry_Stream_DS *state_;
+    std::uint32_t skipped_;
+  };
+
+} // namespace telemetry
+
+#endif // _TELEMETRY_DECODER_HPP_
@@ -0,0 +1,59 @@
+/**
+ * @brief print the frames of a captured stream, e.g. cat /dev/rfcomm0 | ./telemetry
+ *
+ */
+
+#include <cstdio>
+
+#include "TelemetryDecoder.hpp"
+
+// * frame types of projects/RangeFinder, TELEMETRY_KEYFRAME marks whole values
+enum : std::uint8_t
+{
+  ATTITUDE = 0x01, // * stream: roll, pitch (0.01 degree), timestamp (us)
+  DISTANCE = 0x02  // * stream: distance (mm), timestamp (us), horizontal distance (mm)
+};
+
+int main()
+{
+  telemetry::Decoder decoder;
+  telemetry::Stream attitude(3, 16), distance(3, 8);
+  std::vector<std::int32_t> values;
+  std::uint8_t chunk[256];
+  std::size_t len;
+
+  const auto onFrame = [&](const telemetry::Frame &frame)
+  {
+    const std::uint8_t type = frame.type & ~TELEMETRY_KEYFRAME;
+    const char key = (frame.type & TELEMETRY_KEYFRAME) ? '*' : ' ';
+
+    if (type == ATTITUDE)
+    {
+      if (attitude.decode(decoder, values))
+        std::printf("#%03u%c roll %+.2f pitch %+.2f @%u us\n", frame.sequence, key, values[0] / 100.0, values[1] / 100.0, (std::uint32_t)values[2]);
+    }
+    else if (type == DISTANCE)
+    {
+      if (distance.decode(decoder, values))
+        std::printf("#%03u%c distance %d mm (horizontal %d mm) @%u us\n", frame.sequence, key, values[0], values[2], (std::uint32_t)values[1]);
+    }
+    else
+    {
+      telemetry::Reader reader(frame);
+      std::uint32_t field = 0;
+
+      std::printf("#%03u type %02X:", frame.sequence, frame.type);
+      while (reader.next(field))
+        std::printf(" %u", field);
+      std::printf("\n");
+    }
+  };
+
+  while ((len = std::fread(chunk, 1, sizeof(chunk), stdin)) != 0)
+    decoder.feed(chunk, len, onFrame);
+
+  std::fprintf(stderr, "frames %u, lost %u, corrupted %u, waiting for keyframes %u\n",
+               decoder.frames(), decoder.lost(), decoder.corrupted(), attitude.skipped() + distance.skipped());
+
+  return 0;
+}
@@ -0,0 +1,46 @@
+/**
+ * @brief register model of the peripherals driven by host tests, included by Common.h with HOST_TOOLS & HOST_DEVICE
+ * | Register blocks as in the device header, the test defines the instances & plays the hardware.
+ *
+ */
+
+#ifndef _HOST_DEVICE_H_
+#define _HOST_DEVICE_H_
+
+typedef struct
+{
+  volatile uint32_t CRL, CRH, IDR, ODR, BSRR, BRR, LCKR;
+} GPIO_TypeDef;
+
+typedef struct
+{
+  volatile uint32_t SR, DR, BRR, CR1, CR2, CR3, GTPR;
+} USART_TypeDef;
+
+typedef struct
+{
+  volatile uint32_t CCR, CNDTR, CPAR, CMAR; // ! CPAR & CMAR keep the low 32 bits of a host pointer
+} DMA_Channel_TypeDef;
+
+typedef struct
+{
+  volatile uint32_t ISR, IFCR; // ! IFCR does not clear ISR, the test does
+} DMA_TypeDef;
+
+typedef struct
+{
+  volatile uint32_t CR, CFGR, CIR, APB2RSTR, APB1RSTR, AHBENR, APB2ENR, APB1ENR, BDCR, CSR;
+} RCC_TypeDef;
+
+extern USART_TypeDef *USART1, *USART2, *USART3;
+extern DMA_TypeDef *DMA1;
+extern DMA_Channel_TypeDef *DMA1_Channel1, *DMA1_Channel2, *DMA1_Channel3, *DMA1_Channel4, *DMA1_Channel5, *DMA1_Channel6, *DMA1_Channel7;
+extern RCC_TypeDef *RCC;
+extern uint32_t SystemCoreClock;
+
+// ? PRIMASK of the test, its interrupts only run between the calls into the library
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t primask);
+void __disable_irq(void);
+
+#endif // _HOST_DEVICE_H_
@@ -0,0 +1,335 @@
+/**
+ * @brief DSP.c against a double precision reference: FIR, biquad, moving average, CIC & stats over random Q15 blocks
+ *
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#include "DSP.h"
+
+#define SAMPLES 4096
+#define STRIDE 3      // * input interleaved as frames of 3 axes, the middle one is filtered
+#define TAPS 7        // * FIR taps
+#define BLOCK 5       // * FIR block, does not divide TAPS
+#define BIQUAD_ERROR 8 // * LSB: the kernel rounds y before it feeds it back, the reference does not
+
+static q15_t frames[SAMPLES * STRIDE];
+static double x[SAMPLES]; // * the filtered axis
+static int failures;
+
+static void Check(bool_t isPassed, const char *what, uint32_t sample)
+{
+  if (isPassed)
+    return;
+
+  failures++;
+
+  if (failures <= 10)
+    printf("sample %u: %s\n", sample, what);
+}
+
+static uint32_t Random(void)
+{
+  // ? xorshift32, a fixed seed keeps every run the same
+  static uint32_t state = 0x1F123BB5;
+
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+
+  return state;
+}
+
+/**
+ * @brief floor of the square root, stands in for the one of Fusion.c
+ * | Fusion.c reads the DWT cycle counter, it does not build on a host.
+ *
+ */
+uint32_t Fusion_Sqrt(uint32_t n)
+{
+  uint32_t root = (uint32_t)sqrt((double)n);
+
+  while ((uint64_t)root * root > n)
+    root--;
+  while ((uint64_t)(root + 1) * (root + 1) <= n)
+    root++;
+
+  return root;
+}
+
+static double Clamp(double value)
+{
+  return (value > 32767) ? 32767 : (value < -32768) ? -32768 : value;
+}
+
+/**
+ * @brief random Q15 samples of the given amplitude on every axis
+ *
+ */
+static void Fill(sint32_t amplitude)
+{
+  for (size_t i = 0; i < SAMPLES * STRIDE; ++i)
+    frames[i] = (q15_t)((sint32_t)(Random() % (2 * amplitude + 1)) - amplitude);
+
+  for (size_t n = 0; n < SAMPLES; ++n)
+    x[n] = frames[n * STRIDE + 1];
+}
+
+/**
+ * @brief block lengths 5, 3, 1, 4, 2 in turn, none divides TAPS
+ *
+ */
+static size_t Length(size_t call)
+{
+  static const size_t lengths[] = {BLOCK, 3, 1, 4, 2};
+
+  return lengths[call % (sizeof(lengths) / sizeof(lengths[0]))];
+}
+
+static void TestFIR(void)
+{
+  q15_t coeffs[TAPS];
+  q15_t out[SAMPLES];
+
+  // ? sum of |coeffs| above 1, loud samples saturate
+  for (size_t k = 0; k < TAPS; ++k)
+    coeffs[k] = (q15_t)((sint32_t)(Random() % 16385) - 8192);
+
+  Fill(32767);
+
+  DSP_FIR_DS *fir = DSP_FIR_Constructor(coeffs, TAPS, BLOCK);
+
+  Check(DSP_FIR_Process(fir, &frames[1], STRIDE, out, BLOCK + 1) == Fail, "fir: block overrun taken", 0);
+
+  for (size_t n = 0, call = 0; n < SAMPLES; ++call)
+  {
+    size_t len = Length(call);
+    if (n + len > SAMPLES)
+      len = SAMPLES - n;
+
+    Check(DSP_FIR_Process(fir, &frames[n * STRIDE + 1], STRIDE, &out[n], len) == Success, "fir: process", (uint32_t)n);
+    n += len;
+  }
+
+  // ? products & sums are exact in a double, so is the rounding
+  for (size_t n = 0; n < SAMPLES; ++n)
+  {
+    double acc = 0;
+
+    for (size_t k = 0; k < TAPS && k <= n; ++k)
+      acc += coeffs[k] * x[n - k];
+
+    Check(out[n] == Clamp(floor(acc / 32768 + 0.5)), "fir: differs", (uint32_t)n);
+  }
+
+  DSP_FIR_Destructor(fir);
+}
+
+/**
+ * @brief 2nd order Butterworth section (RBJ low-pass), b0 b1 b2 a1 a2 in Q14
+ *
+ */
+static void Section(double cutoff, double q, q15_t c[5])
+{
+  const double w0 = 2 * 3.14159265358979323846 * cutoff, alpha = sin(w0) / (2 * q), a0 = 1 + alpha;
+  const double b[5] = {(1 - cos(w0)) / 2 / a0, (1 - cos(w0)) / a0, (1 - cos(w0)) / 2 / a0, -2 * cos(w0) / a0, (1 - alpha) / a0};
+
+  for (size_t i = 0; i < 5; ++i)
+    c[i] = (q15_t)lround(b[i] * 16384);
+}
+
+static void TestBiquad(void)
+{
+  q15_t coeffs[10];
+  q15_t out[SAMPLES];
+  double y[SAMPLES], error = 0;
+
+  // ? 4th order Butterworth at fs / 20, no headroom needed for half scale noise
+  Section(0.05, 0.5412, &coeffs[0]);
+  Section(0.05, 1.3066, &coeffs[5]);
+
+  Fill(16384);
+
+  DSP_Biquad_DS *biquad = DSP_Biquad_Constructor(coeffs, 2, 1);
+
+  for (size_t n = 0, call = 0; n < SAMPLES; ++call)
+  {
+    size_t len = Length(call) * 13;
+    if (n + len > SAMPLES)
+      len = SAMPLES - n;
+
+    DSP_Biquad_Process(biquad, &frames[n * STRIDE + 1], STRIDE, &out[n], len);
+    n += len;
+  }
+
+  // ? the same cascade in double with the quantized coefficients
+  for (size_t n = 0; n < SAMPLES; ++n)
+    y[n] = x[n];
+
+  for (size_t s = 0; s < 2; ++s)
+  {
+    const q15_t *const c = &coeffs[5 * s];
+    double x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+
+    for (size_t n = 0; n < SAMPLES; ++n)
+    {
+      const double x0 = y[n];
+      const double y0 = (c[0] * x0 + c[1] * x1 + c[2] * x2 - c[3] * y1 - c[4] * y2) / 16384;
+
+      x2 = x1;
+      x1 = x0;
+      y2 = y1;
+      y1 = y0;
+      y[n] = y0;
+    }
+  }
+
+  for (size_t n = 0; n < SAMPLES; ++n)
+  {
+    Check(fabs(out[n] - y[n]) <= BIQUAD_ERROR, "biquad: off the reference", (uint32_t)n);
+
+    if (fabs(out[n] - y[n]) > error)
+      error = fabs(out[n] - y[n]);
+  }
+
+  printf("biquad: max error %.2f LSB\n", error);
+
+  DSP_Biquad_Destructor(biquad);
+}
+
+static void TestAverage(void)
+{
+  const size_t size = 9;
+  q15_t out[SAMPLES];
+
+  Fill(32767);
+
+  DSP_Average_DS *average = DSP_Average_Constructor(size);
+
+  for (size_t n = 0, call = 0; n < SAMPLES; ++call)
+  {
+    size_t len = Length(call);
+    if (n + len > SAMPLES)
+      len = SAMPLES - n;
+
+    DSP_Average_Process(average, &frames[n * STRIDE + 1], STRIDE, &out[n], len);
+    n += len;
+  }
+
+  // ? partial window first, the mean truncated toward zero
+  for (size_t n = 0; n < SAMPLES; ++n)
+  {
+    const size_t count = (n + 1 < size) ? n + 1 : size;
+    double sum = 0;
+
+    for (size_t k = 0; k < count; ++k)
+      sum += x[n - k];
+
+    Check(out[n] == trunc(sum / count), "average: differs", (uint32_t)n);
+  }
+
+  DSP_Average_Destructor(average);
+}
+
+static void TestCIC(uint8_t order, size_t ratio)
+{
+  q15_t out[SAMPLES];
+  double y[SAMPLES];
+  size_t total = 0, count = 0;
+
+  Fill(32767);
+
+  DSP_CIC_DS *cic = DSP_CIC_Constructor(order, ratio);
+
+  for (size_t n = 0, call = 0; n < SAMPLES; ++call)
+  {
+    size_t len = Length(call) * 7;
+    if (n + len > SAMPLES)
+      len = SAMPLES - n;
+
+    Check(DSP_CIC_Process(cic, &frames[n * STRIDE + 1], STRIDE, len, &out[total], len / ratio + 1, &count) == Success, "cic: process", (uint32_t)n);
+    total += count;
+    n += len;
+  }
+
+  Check(total == SAMPLES / ratio, "cic: output count", (uint32_t)total);
+
+  // ? order boxcars of ratio samples, taken at every ratio-th sample & divided by the gain
+  for (size_t n = 0; n < SAMPLES; ++n)
+    y[n] = x[n];
+
+  for (uint8_t k = 0; k < order; ++k)
+  {
+    double sum = 0, shifted[SAMPLES];
+
+    for (size_t n = 0; n < SAMPLES; ++n)
+    {
+      sum += y[n] - ((n >= ratio) ? y[n - ratio] : 0);
+      shifted[n] = sum;
+    }
+
+    for (size_t n = 0; n < SAMPLES; ++n)
+      y[n] = shifted[n];
+  }
+
+  const double gain = pow((double)ratio, order);
+
+  for (size_t m = 0; m < total; ++m)
+    Check(out[m] == Clamp(floor(y[(m + 1) * ratio - 1] / gain)), "cic: differs", (uint32_t)m);
+
+  // ? no room for the output: refused
+  DSP_CIC_Reset(cic);
+  Check(DSP_CIC_Process(cic, &frames[1], STRIDE, 2 * ratio, out, 1, &count) == Fail && count == 1, "cic: full output taken", 0);
+
+  DSP_CIC_Destructor(cic);
+}
+
+static void TestStats(void)
+{
+  DSP_Stats_t stats;
+
+  Fill(32767);
+
+  Check(DSP_Stats(frames, STRIDE, 0, &stats) == Fail, "stats: empty block taken", 0);
+
+  for (size_t n = 0, call = 0; n < SAMPLES; ++call)
+  {
+    size_t len = Length(call) * 11;
+    if (n + len > SAMPLES)
+      len = SAMPLES - n;
+
+    double min = x[n], max = x[n], sum = 0, square = 0;
+
+    for (size_t i = n; i < n + len; ++i)
+    {
+      min = (x[i] < min) ? x[i] : min;
+      max = (x[i] > max) ? x[i] : max;
+      sum += x[i];
+      square += x[i] * x[i];
+    }
+
+    Check(DSP_Stats(&frames[n * STRIDE + 1], STRIDE, len, &stats) == Success, "stats: process", (uint32_t)n);
+    Check(stats.min == min && stats.max == max, "stats: min & max", (uint32_t)n);
+    Check(stats.mean == trunc(sum / len), "stats: mean", (uint32_t)n);
+    Check(fabs(stats.rms - Clamp(sqrt(square / len))) <= 1, "stats: rms", (uint32_t)n);
+
+    n += len;
+  }
+}
+
+int main(void)
+{
+  TestFIR();
+  TestBiquad();
+  TestAverage();
+  TestCIC(1, 8);
+  TestCIC(3, 16);
+  TestCIC(4, 16);
+  TestStats();
+
+  printf("samples %u, fir %u taps by blocks of up to %u\n", SAMPLES, TAPS, BLOCK);
+  printf("%s, %d failures\n", failures ? "FAIL" : "PASS", failures);
+
+  return failures;
+}
@@ -0,0 +1,151 @@
+/**
+ * @brief Display.c on a host GPIO model: each scan lights exactly one digit with its glyph & point, bad positions & values refused
+ *
+ */
+
+#include <stdio.h>
+
+#include "Display.h"
+
+#define DIGITS 4
+
+// ? a port per common & one for the segments: every BSRR write of a scan lands on its own port
+static GPIO_TypeDef gpio[DIGITS + 1];
+static GPIO_TypeDef *const segments = &gpio[DIGITS];
+static int failures;
+
+static void Check(bool_t isPassed, const char *what, uint32_t scan)
+{
+  if (isPassed)
+    return;
+
+  failures++;
+  printf("scan %u: %s\n", scan, what);
+}
+
+/**
+ * @brief take the BSRR word of each port into its ODR, set bits win as on the device
+ *
+ */
+static void Apply(void)
+{
+  for (size_t i = 0; i < DIGITS + 1; ++i)
+  {
+    const uint32_t word = gpio[i].BSRR;
+
+    gpio[i].ODR = (gpio[i].ODR & ~(word >> 16)) | (word & 0xFFFF);
+    gpio[i].BSRR = 0;
+  }
+}
+
+/**
+ * @brief one scan, read back which digits are lit & the glyph on the segments (active low)
+ *
+ * @return size_t: position lit, DIGITS -> none or more than one
+ */
+static size_t Scan(Display_DS *const display, const port_t common[], const port_t io[], flag8_t *const glyph)
+{
+  Display_Scan(display);
+  Apply();
+
+  size_t lit = DIGITS, count = 0;
+
+  for (size_t i = 0; i < DIGITS; ++i)
+    if (!_MASK(common[i].GPIOx->ODR, _BIT(common[i].order)))
+    {
+      lit = i;
+      count++;
+    }
+
+  *glyph = 0;
+
+  for (size_t i = 0; i < 8; ++i)
+    if (!_MASK(io[i].GPIOx->ODR, _BIT(io[i].order)))
+      *glyph |= (flag8_t)_BIT(i);
+
+  return (count == 1) ? lit : DIGITS;
+}
+
+/**
+ * @brief scan two rounds: digits lit in turn, each with the glyph expected
+ *
+ */
+static void Rounds(Display_DS *const display, const port_t common[], const port_t io[], const flag8_t expected[DIGITS], uint32_t *const scans)
+{
+  for (size_t n = 0; n < 2 * DIGITS; ++n, ++*scans)
+  {
+    const size_t position = (display->position + 1) % DIGITS;
+    flag8_t glyph;
+
+    Check(Scan(display, common, io, &glyph) == position, "not exactly the next digit lit", *scans);
+    Check(glyph == expected[position], "wrong glyph", *scans);
+  }
+}
+
+int main(void)
+{
+  const port_t common[DIGITS] = {{&gpio[0], 14}, {&gpio[1], 13}, {&gpio[2], 12}, {&gpio[3], 15}};
+  const port_t io[8] = {{segments, 8}, {segments, 3}, {segments, 11}, {segments, 1}, {segments, 0}, {segments, 4}, {segments, 9}, {segments, 10}};
+  uint32_t scans = 0;
+
+  Check(Display_Constructor(common, 0, io) == 0, "no digits taken", scans);
+
+  Display_DS *display = Display_Constructor(common, DIGITS, io);
+  Apply();
+
+  Check(display != 0, "constructor failed", scans);
+  if (display == 0)
+    return 1;
+
+  for (size_t i = 0; i < DIGITS; ++i)
+    Check(_MASK(common[i].GPIOx->ODR, _BIT(common[i].order)) != 0, "digit lit by the constructor", scans);
+
+  // blank until the first show
+  const flag8_t blank[DIGITS] = {DISPLAY_BLANK, DISPLAY_BLANK, DISPLAY_BLANK, DISPLAY_BLANK};
+  Rounds(display, common, io, blank, &scans);
+
+  // decimal with a point, position 0 is the rightmost digit
+  Check(Display_Unsigned(display, 1234, 2) == Success, "unsigned", scans);
+  Rounds(display, common, io, blank, &scans); // ? back buffer only, nothing shown yet
+
+  Display_Show(display);
+  const flag8_t number[DIGITS] = {Num4, Num3, Num2 | SegP, Num1};
+  Rounds(display, common, io, number, &scans);
+
+  // higher digits cut, no point past the last digit
+  Display_Unsigned(display, 98765, DIGITS);
+  Display_Show(display);
+  const flag8_t cut[DIGITS] = {Num5, Num6, Num7, Num8};
+  Rounds(display, common, io, cut, &scans);
+
+  // hex digits & raw glyphs
+  Check(Display_Digit(display, 0, 0x0F, False) == Success && Display_Digit(display, 1, 0x0A, True) == Success &&
+            Display_Digit(display, 2, 0x00, False) == Success && Display_Glyph(display, 3, SegG) == Success,
+        "digits", scans);
+
+  // ? out of range: refused, the back buffer untouched
+  Check(Display_Glyph(display, DIGITS, Num8) == Fail, "glyph past the last digit", scans);
+  Check(Display_Digit(display, DIGITS, 1, False) == Fail, "digit past the last digit", scans);
+  Check(Display_Digit(display, 0, 0x10, False) == Fail, "value above 0xF", scans);
+
+  Display_Show(display);
+  const flag8_t hex[DIGITS] = {SegA | SegE | SegF | SegG, SegA | SegB | SegC | SegE | SegF | SegG | SegP, Num0, SegG};
+  Rounds(display, common, io, hex, &scans);
+
+  // one digit changed, the others keep the frame shown, not the one before it
+  Display_Digit(display, 2, 7, True);
+  Display_Show(display);
+  const flag8_t changed[DIGITS] = {hex[0], hex[1], Num7 | SegP, hex[3]};
+  Rounds(display, common, io, changed, &scans);
+
+  // a swap without writes keeps the frame
+  Display_Show(display);
+  Rounds(display, common, io, changed, &scans);
+
+  Display_Destructor(display);
+
+  printf("scans %u over %u digits\n", scans, DIGITS);
+  printf("%s, %d failures\n", failures ? "FAIL" : "PASS", failures);
+
+  return failures;
+}
@@ -0,0 +1,165 @@
+/**
+ * @brief Format.c against snprintf: random values over every width, pad & decimal count, Div10 over a sweep
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Format.h"
+
+#define VALUES 200000
+#define MAX_WIDTH 12
+#define SWEEP_STEP 13 // * Div10 checked on every 13th value of the 32-bit range, and around the ends
+
+static int failures;
+
+static uint32_t Random(void)
+{
+  // ? xorshift32, a fixed seed keeps every run the same
+  static uint32_t state = 0x2545F491;
+
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+
+  return state;
+}
+
+/**
+ * @brief compare a Format result with the snprintf text, then check the same call refuses a span one byte short
+ *
+ */
+static void Compare(const uint8_t str[], size_t len, const char *expected, size_t refused, const char *what, uint32_t value)
+{
+  if (len == strlen(expected) && memcmp(str, expected, len) == 0 && refused == 0)
+    return;
+
+  failures++;
+
+  if (failures <= 10)
+    printf("%s %u: \"%.*s\" (%u), expected \"%s\", short span -> %u\n", what, value, (int)len, str, (unsigned)len, expected, (unsigned)refused);
+}
+
+int main(void)
+{
+  uint8_t str[32], untouched[32];
+  char expected[32];
+
+  memset(untouched, '#', sizeof(untouched));
+
+  for (uint32_t n = 0; n < VALUES; ++n)
+  {
+    // ? short values too, where the padding shows
+    const uint32_t value = Random() >> (Random() % 32);
+    const sint32_t signedValue = (sint32_t)value * ((n & 1) ? -1 : 1);
+
+    for (size_t width = 0; width <= MAX_WIDTH; ++width)
+    {
+      size_t len, refused;
+
+      // unsigned, both pads
+      snprintf(expected, sizeof(expected), "%*u", (int)width, value);
+      len = Format_Unsigned(str, sizeof(str), value, width, ' ');
+      refused = Format_Unsigned(untouched, strlen(expected) - 1, value, width, ' ');
+      Compare(str, len, expected, refused, "unsigned", value);
+
+      snprintf(expected, sizeof(expected), "%0*u", (int)width, value);
+      len = Format_Unsigned(str, sizeof(str), value, width, '0');
+      refused = Format_Unsigned(untouched, strlen(expected) - 1, value, width, '0');
+      Compare(str, len, expected, refused, "unsigned '0'", value);
+
+      // signed, both pads
+      snprintf(expected, sizeof(expected), "%*d", (int)width, signedValue);
+      len = Format_Signed(str, sizeof(str), signedValue, width, ' ');
+      refused = Format_Signed(untouched, strlen(expected) - 1, signedValue, width, ' ');
+      Compare(str, len, expected, refused, "signed", value);
+
+      snprintf(expected, sizeof(expected), "%0*d", (int)width, signedValue);
+      len = Format_Signed(str, sizeof(str), signedValue, width, '0');
+      refused = Format_Signed(untouched, strlen(expected) - 1, signedValue, width, '0');
+      Compare(str, len, expected, refused, "signed '0'", value);
+
+      // fixed point, every decimal count
+      for (uint8_t decimals = 0; decimals <= 9; ++decimals)
+      {
+        uint32_t scale = 1;
+        for (uint8_t i = 0; i < decimals; ++i)
+          scale *= 10;
+
+        const uint32_t magnitude = (signedValue < 0) ? 0U - (uint32_t)signedValue : (uint32_t)signedValue;
+        char text[32];
+
+        if (decimals)
+          snprintf(text, sizeof(text), "%s%u.%0*u", (signedValue < 0) ? "-" : "", magnitude / scale, (int)decimals, magnitude % scale);
+        else
+          snprintf(text, sizeof(text), "%d", signedValue);
+
+        snprintf(expected, sizeof(expected), "%*s", (int)width, text);
+        len = Format_Fixed(str, sizeof(str), signedValue, decimals, width);
+        refused = Format_Fixed(untouched, strlen(expected) - 1, signedValue, decimals, width);
+        Compare(str, len, expected, refused, "fixed", value);
+      }
+
+      // hex, width taken as min digits
+      snprintf(expected, sizeof(expected), "%0*X", (int)width, value);
+      len = Format_Hex(str, sizeof(str), value, width);
+      refused = Format_Hex(untouched, strlen(expected) - 1, value, width);
+      Compare(str, len, expected, refused, "hex", value);
+    }
+  }
+
+  // ? a span one byte short must be left as it was
+  for (size_t i = 0; i < sizeof(untouched); ++i)
+    if (untouched[i] != '#')
+    {
+      failures++;
+      printf("short span written at %u\n", (unsigned)i);
+      break;
+    }
+
+  // ? ends of the types
+  const struct
+  {
+    sint32_t value;
+    const char *text;
+  } edges[] = {{0, "0"}, {-1, "-1"}, {2147483647, "2147483647"}, {(sint32_t)0x80000000, "-2147483648"}};
+
+  for (size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); ++i)
+  {
+    const size_t len = Format_Signed(str, sizeof(str), edges[i].value, 0, ' ');
+    Compare(str, len, edges[i].text, 0, "edge", (uint32_t)edges[i].value);
+  }
+
+  Compare(str, Format_Unsigned(str, sizeof(str), 0xFFFFFFFF, 0, ' '), "4294967295", 0, "edge", 0xFFFFFFFF);
+  Compare(str, Format_Fixed(str, sizeof(str), -5, 2, 0), "-0.05", 0, "edge", 5);
+
+  if (Format_Fixed(str, sizeof(str), 1, 10, 0) != 0)
+  {
+    failures++;
+    printf("fixed: 10 decimals accepted\n");
+  }
+
+  // ? Div10 over a sweep of the range, both ends included
+  uint32_t checked = 0;
+
+  for (uint64_t value = 0; value <= 0xFFFFFFFFULL; value += (value < 1000 || value > 0xFFFFFC00ULL) ? 1 : SWEEP_STEP)
+  {
+    uint8_t digit = 0xFF;
+    const uint32_t quotient = Format_Div10((uint32_t)value, &digit);
+
+    if (quotient != (uint32_t)value / 10 || digit != (uint32_t)value % 10)
+    {
+      failures++;
+      printf("div10 %u: %u rem %u\n", (uint32_t)value, quotient, digit);
+      break;
+    }
+
+    checked++;
+  }
+
+  printf("values %u, widths 0 ~ %u, div10 %u values\n", VALUES, MAX_WIDTH, checked);
+  printf("%s, %d failures\n", failures ? "FAIL" : "PASS", failures);
+
+  return failures;
+}
@@ -0,0 +1,447 @@
+/**
+ * @brief TX queue of HC05.c on a model of the USART1 TX DMA: marks, drops & HC05_BLOCK, messages arrive whole & in order
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "HC05.h"
+
+#define MESSAGES 200000 // * random messages of the soak
+#define HEAD 4          // * 0xA5, length, id low, id high
+
+// ? the hardware of the test
+static USART_TypeDef usart[3];
+static DMA_TypeDef dma;
+static DMA_Channel_TypeDef channel[7];
+static RCC_TypeDef rcc;
+
+USART_TypeDef *USART1 = &usart[0], *USART2 = &usart[1], *USART3 = &usart[2];
+DMA_TypeDef *DMA1 = &dma;
+DMA_Channel_TypeDef *DMA1_Channel1 = &channel[0], *DMA1_Channel2 = &channel[1], *DMA1_Channel3 = &channel[2], *DMA1_Channel4 = &channel[3],
+                    *DMA1_Channel5 = &channel[4], *DMA1_Channel6 = &channel[5], *DMA1_Channel7 = &channel[6];
+RCC_TypeDef *RCC = &rcc;
+uint32_t SystemCoreClock = 72000000;
+
+static uint32_t primask;
+
+uint32_t __get_PRIMASK(void)
+{
+  return primask;
+}
+
+void __set_PRIMASK(uint32_t value)
+{
+  primask = value;
+}
+
+void __disable_irq(void)
+{
+  primask = 1;
+}
+
+static HC05_DS *hc05;
+static Buffer_DS *tx;
+
+static uint8_t flight[0xFFFF]; // * bytes of the region in flight, as the DMA started it
+static size_t flightLen;
+static bool_t isFlight;
+
+static uint8_t wire[MESSAGES * 32];
+static size_t length, parsed;
+
+static int failures;
+
+static void Check(bool_t isPassed, const char *what, uint32_t id)
+{
+  if (isPassed)
+    return;
+
+  failures++;
+
+  if (failures <= 10)
+    printf("message %u: %s\n", id, what);
+}
+
+/**
+ * @brief look at the channel after each call into HC05, take the region it was started with
+ *
+ */
+static void Observe(void)
+{
+  Check(primask == 0, "interrupts left masked", 0);
+
+  if (isFlight || !_MASK(DMA1_Channel4->CCR, _BIT(0)))
+    return;
+
+  const uint8_t *region = 0;
+  const size_t contiguous = Buffer_Region(tx, &region);
+
+  flightLen = DMA1_Channel4->CNDTR;
+
+  Check(DMA1_Channel4->CMAR == (uint32_t)(uintptr_t)region, "DMA not started at the head", 0);
+  Check(flightLen != 0 && flightLen <= contiguous, "DMA past the contiguous region", 0);
+
+  memcpy(flight, region, flightLen);
+  isFlight = True;
+}
+
+/**
+ * @brief the DMA finishes the region in flight & raises TC, the handler chains the next one
+ *
+ * @return bool_t: True (a region went out) / False (idle)
+ */
+static bool_t Complete(void)
+{
+  if (!isFlight)
+    return False;
+
+  const uint8_t *region = 0;
+  Buffer_Region(tx, &region);
+
+  // ? nothing may move the bytes under the DMA
+  Check(memcmp(region, flight, flightLen) == 0, "region in flight changed", 0);
+
+  memcpy(&wire[length], flight, flightLen);
+  length += flightLen;
+  isFlight = False;
+
+  DMA1->ISR = _InterfaceDMA_Flag(4, DMA_GIF | DMA_TCIF);
+  HC05_TxIRQHandler(hc05);
+  DMA1->ISR = 0;
+
+  Observe();
+
+  return True;
+}
+
+static void Drain(void)
+{
+  while (Complete())
+  {
+  }
+}
+
+static void Make(uint8_t message[], uint32_t id, size_t len)
+{
+  message[0] = 0xA5;
+  message[1] = (uint8_t)len;
+  message[2] = (uint8_t)id;
+  message[3] = (uint8_t)(id >> 8);
+
+  for (size_t i = HEAD; i < len; ++i)
+    message[i] = (uint8_t)(id * 7 + i);
+}
+
+/**
+ * @brief queue one message, by HC05_SendWith or pushed straight into tx as Telemetry_End does
+ *
+ */
+static task_t Queue(uint32_t id, size_t len, HC05_Policy_Enum policy, uint32_t timeout, bool_t isDirect)
+{
+  uint8_t message[64];
+  task_t status;
+
+  Make(message, id, len);
+
+  if (!isDirect)
+  {
+    status = HC05_SendWith(hc05, message, len, policy, timeout);
+    Observe();
+    return status;
+  }
+
+  status = HC05_Reserve(hc05, len, policy, timeout);
+  Observe();
+
+  if (status != Success)
+    return status;
+
+  for (size_t i = 0; i < len; ++i)
+    Buffer_Push(tx, message[i]);
+
+  status = HC05_Transmit(hc05);
+  Observe();
+
+  return status;
+}
+
+/**
+ * @brief read whole messages off the wire
+ *
+ * @param ids: save the ids received
+ * @param capacity: messages to read at most
+ * @return size_t: messages read
+ */
+static size_t Received(uint32_t ids[], size_t capacity)
+{
+  size_t count = 0;
+
+  while (parsed < length && count < capacity)
+  {
+    const uint8_t *const message = &wire[parsed];
+    const size_t len = message[1];
+    const uint32_t id = message[2] | (uint32_t)message[3] << 8;
+
+    if (message[0] != 0xA5 || len < HEAD || parsed + len > length)
+    {
+      Check(False, "cut on the wire", id);
+      parsed = length;
+      break;
+    }
+
+    for (size_t i = HEAD; i < len; ++i)
+      if (message[i] != (uint8_t)(id * 7 + i))
+      {
+        Check(False, "bytes of a message differ", id);
+        break;
+      }
+
+    ids[count++] = id;
+    parsed += len;
+  }
+
+  return count;
+}
+
+static void Expect(const uint32_t expected[], size_t count, const char *what)
+{
+  uint32_t ids[32];
+  const size_t received = Received(ids, 32);
+  bool_t isSame = (received == count) ? True : False;
+
+  for (size_t i = 0; isSame && i < count; ++i)
+    if (ids[i] != expected[i])
+      isSame = False;
+
+  Check(isSame, what, 0);
+}
+
+static void Setup(size_t size)
+{
+  memset(&dma, 0, sizeof(dma));
+  memset(channel, 0, sizeof(channel));
+
+  USART1->BRR = 625; // * 115200 bit/s on 72 MHz
+
+  hc05 = HC05_Constructor(USART1);
+  tx = Buffer_Constructor(size);
+  HC05_AttachTx(hc05, tx);
+
+  isFlight = False;
+  length = parsed = 0;
+}
+
+static void Teardown(void)
+{
+  HC05_Destructor(hc05);
+  Buffer_Destructor(tx);
+}
+
+/**
+ * @brief a message not started by the DMA crosses the end of the array & is cut out
+ *
+ */
+static void TestWrapCut(void)
+{
+  Setup(16);
+
+  Queue(0, 6, HC05_DROP_OLDEST, 0, False);
+  Complete(); // ? head at 6
+
+  Queue(1, 6, HC05_DROP_OLDEST, 0, False); // in flight: 6 ~ 11
+  Queue(2, 6, HC05_DROP_OLDEST, 0, True);  // 12 ~ 15, 0 ~ 1
+
+  // ? the array ends inside message 2: 6 bytes from the head, 12 queued
+  const uint8_t *region = 0;
+  Check(Buffer_Region(tx, &region) == 10 && Buffer_Length(tx) == 12, "message 2 not across the wrap", 2);
+
+  Check(Queue(3, 5, HC05_DROP_OLDEST, 0, False) == Success, "no room made", 3);
+  Check(HC05_GetDropped(hc05) == 1 && Buffer_Length(tx) == 11, "not only message 2 cut", 2);
+
+  Drain();
+
+  const uint32_t expected[] = {0, 1, 3};
+  Expect(expected, 3, "wrap cut: wrong messages on the wire");
+
+  Teardown();
+}
+
+/**
+ * @brief the oldest message went out in part, it is kept whatever the policy needs
+ *
+ */
+static void TestPartlySent(void)
+{
+  Setup(16);
+
+  Queue(0, 10, HC05_DROP_OLDEST, 0, False);
+  Complete(); // ? head at 10
+
+  Queue(1, 10, HC05_DROP_OLDEST, 0, False); // in flight: 10 ~ 15, then 0 ~ 3
+  Complete();
+
+  Check(hc05->tx.done == 6 && isFlight && flightLen == 4, "message 1 not partly sent", 1);
+
+  Queue(2, 4, HC05_DROP_OLDEST, 0, False);
+  Queue(3, 8, HC05_DROP_OLDEST, 0, False);
+
+  Check(Queue(4, 6, HC05_DROP_OLDEST, 0, False) == Success, "no room made", 4);
+  Check(HC05_GetDropped(hc05) == 2, "partly sent message dropped", 1);
+
+  Drain();
+
+  const uint32_t expected[] = {0, 1, 4};
+  Expect(expected, 3, "partly sent: wrong messages on the wire");
+
+  Teardown();
+}
+
+/**
+ * @brief more messages than HC05_TX_MARKS: the newest are merged & dropped together
+ *
+ */
+static void TestMergedMarks(void)
+{
+  Setup(64);
+
+  Queue(0, 4, HC05_DROP_OLDEST, 0, False); // in flight
+
+  for (uint32_t id = 1; id <= 20; ++id)
+    Check(Queue(id, 3, HC05_DROP_OLDEST, 0, id & 1) == Success, "not queued", id);
+
+  Check(hc05->tx.count == HC05_TX_MARKS && hc05->tx.marked == Buffer_Length(tx), "marks not merged", 20);
+
+  // ? 14 single marks free 42 bytes, the merged one (15 ~ 20) has to go as a whole
+  Check(Queue(21, 45, HC05_DROP_OLDEST, 0, True) == Success, "no room made", 21);
+  Check(HC05_GetDropped(hc05) == 15, "merged mark not dropped as one", 21);
+
+  Drain();
+
+  const uint32_t expected[] = {0, 21};
+  Expect(expected, 2, "merged marks: wrong messages on the wire");
+
+  Teardown();
+}
+
+/**
+ * @brief HC05_BLOCK: never fits, tries run out, nothing in flight
+ *
+ */
+static void TestBlock(void)
+{
+  Setup(16);
+
+  Check(Queue(0, 17, HC05_BLOCK, 1000, False) == Fail && Buffer_Length(tx) == 0, "longer than the buffer taken", 0);
+
+  Check(Queue(0, 12, HC05_BLOCK, 0, False) == Success, "room there, not queued", 0); // in flight
+
+  // ? the model DMA never finishes inside the wait, every try fails
+  Check(Queue(1, 8, HC05_BLOCK, 0, False) == Fail && Buffer_Length(tx) == 12, "no try left, queued", 1);
+  Check(Queue(1, 8, HC05_BLOCK, 100000, True) == Fail && Buffer_Length(tx) == 12, "tries ran out, queued", 1);
+
+  Complete();
+
+  // ? a message in the making fills the buffer, nothing is marked so nothing is in flight
+  uint8_t message[10];
+  Make(message, 1, sizeof(message));
+
+  for (size_t i = 0; i < sizeof(message); ++i)
+    Buffer_Push(tx, message[i]);
+
+  Check(!hc05->tx.isBusy, "DMA busy", 1);
+  Check(Queue(2, 8, HC05_BLOCK, 0xFFFFFFFF, False) == Fail && Buffer_Length(tx) == 10, "idle DMA waited on, queued", 2);
+
+  HC05_Transmit(hc05);
+  Observe();
+  Drain();
+
+  const uint32_t expected[] = {0, 1};
+  Expect(expected, 2, "block: wrong messages on the wire");
+
+  Teardown();
+}
+
+static uint32_t Random(void)
+{
+  // ? xorshift32, a fixed seed keeps every run the same
+  static uint32_t state = 0x6C8E9CF5;
+
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+
+  return state;
+}
+
+/**
+ * @brief random lengths, policies & paths, the DMA finishes at random points
+ * | Messages of 4 bytes at least in 64: the marks never merge, each drop is one message.
+ *
+ */
+static void TestSoak(void)
+{
+  static bool_t isAccepted[MESSAGES];
+  uint32_t accepted = 0, received = 0, wrapped = 0;
+
+  Setup(64);
+
+  for (uint32_t id = 0; id < MESSAGES; ++id)
+  {
+    const size_t len = HEAD + Random() % 20;
+    const HC05_Policy_Enum policy = (HC05_Policy_Enum)(Random() % 3);
+
+    const uint8_t *region = 0;
+    if (Buffer_Region(tx, &region) < Buffer_Length(tx))
+      wrapped++;
+
+    isAccepted[id] = (Queue(id, len, policy, Random() % 4, Random() & 1) == Success) ? True : False;
+    accepted += isAccepted[id] ? 1 : 0;
+
+    if (Random() % 3 == 0)
+      Complete();
+  }
+
+  Drain();
+
+  // ? ids wrap at 16 bits on the wire, in order they are read back in full
+  uint32_t last = 0;
+  bool_t isFirst = True;
+
+  while (parsed < length)
+  {
+    uint32_t id16;
+    if (Received(&id16, 1) != 1)
+      break;
+
+    uint32_t id = isFirst ? id16 : last + (uint16_t)(id16 - last);
+
+    Check(isFirst || id > last, "out of order", id);
+    Check(id < MESSAGES && isAccepted[id], "refused message sent", id);
+
+    last = id;
+    isFirst = False;
+    received++;
+  }
+
+  Check(received + HC05_GetDropped(hc05) == accepted, "accepted messages lost", accepted);
+  Check(Buffer_Length(tx) == 0 && HC05_isTxIdle(hc05), "bytes left", 0);
+
+  printf("soak: accepted %u, received %u, dropped %u, queue across the wrap %u times\n", accepted, received, HC05_GetDropped(hc05), wrapped);
+
+  Teardown();
+}
+
+int main(void)
+{
+  TestWrapCut();
+  TestPartlySent();
+  TestMergedMarks();
+  TestBlock();
+  TestSoak();
+
+  printf("%s, %d failures\n", failures ? "FAIL" : "PASS", failures);
+
+  return failures;
+}
@@ -0,0 +1,135 @@
+/**
+ * @brief SevenSegment.c on a host GPIO model: pin levels of the BSRR words against the old per-pin writes, all 256 glyphs
+ *
+ */
+
+#include <stdio.h>
+
+#include "SevenSegment.h"
+
+static GPIO_TypeDef gpio[4]; // * GPIOA ~ GPIOD
+static int failures;
+
+static void Check(bool_t isPassed, const char *what, uint32_t glyph)
+{
+  if (isPassed)
+    return;
+
+  failures++;
+  printf("glyph %u: %s\n", glyph, what);
+}
+
+/**
+ * @brief take the BSRR word of each port into its ODR, set bits win as on the device
+ *
+ * @return size_t: ports written
+ */
+static size_t Apply(void)
+{
+  size_t writes = 0;
+
+  for (size_t i = 0; i < 4; ++i)
+  {
+    const uint32_t word = gpio[i].BSRR;
+
+    if (word == 0)
+      continue;
+
+    gpio[i].ODR = (gpio[i].ODR & ~(word >> 16)) | (word & 0xFFFF);
+    gpio[i].BSRR = 0;
+    writes++;
+  }
+
+  return writes;
+}
+
+/**
+ * @brief pin levels the old SevenSegment_Set() left: one BSRR write per segment, then the common
+ *
+ */
+static void Expected(const port_t *const common, const port_t io[], flag8_t glyph, uint32_t odr[4])
+{
+  for (size_t i = 0; i < 8; ++i)
+  {
+    uint32_t *const level = &odr[io[i].GPIOx - gpio];
+
+    if (_MASK(glyph, _BIT(i)))
+      *level &= ~_BIT(io[i].order);
+    else
+      *level |= _BIT(io[i].order);
+  }
+
+  odr[common->GPIOx - gpio] &= ~_BIT(common->order);
+}
+
+static void Run(const char *name, const port_t *const common, const port_t io[], size_t ports, bool_t isApart)
+{
+  const int before = failures;
+  SevenSegment_DS *display = SevenSegment_Constructor(common, io);
+
+  Check(display != 0, "constructor failed", 0);
+  if (display == 0)
+    return;
+
+  Check(display->count == ports && display->isApart == isApart, "ports of the tables", 0);
+
+  // ? pins of other users must keep their level, whatever it is
+  const uint32_t origins[] = {0x0000, 0xFFFF, 0x5A5A};
+
+  for (size_t o = 0; o < sizeof(origins) / sizeof(origins[0]); ++o)
+  {
+    for (uint32_t glyph = 0; glyph < 256; ++glyph)
+    {
+      uint32_t odr[4];
+
+      for (size_t i = 0; i < 4; ++i)
+        odr[i] = gpio[i].ODR = origins[o];
+
+      Expected(common, io, (flag8_t)glyph, odr);
+
+      SevenSegment_Set(display, (flag8_t)glyph);
+      const size_t writes = Apply();
+
+      Check(writes == ports + (isApart ? 1 : 0), "one write per port", glyph);
+
+      for (size_t i = 0; i < 4; ++i)
+        Check(gpio[i].ODR == odr[i], "pin levels differ", glyph);
+
+      // ? the common goes off alone, the segments stay as they are
+      odr[common->GPIOx - gpio] |= _BIT(common->order);
+
+      SevenSegment_Reset(display);
+      Apply();
+
+      for (size_t i = 0; i < 4; ++i)
+        Check(gpio[i].ODR == odr[i], "reset touched more than the common", glyph);
+    }
+  }
+
+  printf("%s: ports %u%s, %s\n", name, (unsigned)display->count, display->isApart ? " & the common apart" : "", (failures == before) ? "same levels" : "differ");
+
+  SevenSegment_Destructor(display);
+}
+
+int main(void)
+{
+  GPIO_TypeDef *const GPIOA = &gpio[0], *const GPIOB = &gpio[1], *const GPIOC = &gpio[2], *const GPIOD = &gpio[3];
+
+  // segments on three ports, the common folded into one of them
+  const port_t mixed[8] = {{GPIOB, 2}, {GPIOB, 0}, {GPIOA, 1}, {GPIOB, 3}, {GPIOA, 9}, {GPIOC, 11}, {GPIOA, 8}, {GPIOB, 12}};
+  const port_t commonB = {GPIOB, 15};
+  Run("three ports", &commonB, mixed, 3, False);
+
+  // segments on three ports, the common on a fourth
+  const port_t commonD = {GPIOD, 2};
+  Run("three ports, common apart", &commonD, mixed, 3, True);
+
+  // segments on one port, the common on another
+  const port_t single[8] = {{GPIOA, 0}, {GPIOA, 1}, {GPIOA, 2}, {GPIOA, 3}, {GPIOA, 4}, {GPIOA, 5}, {GPIOA, 6}, {GPIOA, 7}};
+  const port_t commonC = {GPIOC, 13};
+  Run("one port, common apart", &commonC, single, 1, True);
+
+  printf("%s, %d failures\n", failures ? "FAIL" : "PASS", failures);
+
+  return failures;
+}
@@ -0,0 +1,191 @@
+/**
+ * @brief Shell.c on a host: tokenizer, multi-word names, lines split over feeds, usage errors & overflow
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Shell.h"
+
+static char output[512]; // * everything the shell printed since the last Expect()
+static size_t printed;
+
+static char words[SHELL_MAX_TOKENS][SHELL_MAX_LINE + 1]; // * arguments the last handler saw
+static size_t argCount;
+static uint32_t rate;
+static int failures;
+
+static void Check(bool_t isPassed, const char *what, uint32_t step)
+{
+  if (isPassed)
+    return;
+
+  failures++;
+  printf("step %u: %s\n", step, what);
+}
+
+static void Print(const uint8_t str[], size_t len, void *context)
+{
+  (void)context;
+
+  if (printed + len < sizeof(output))
+  {
+    memcpy(&output[printed], str, len);
+    printed += len;
+    output[printed] = '\0';
+  }
+}
+
+static task_t Record(const Shell_Token_t args[], size_t argc, void *context)
+{
+  (void)context;
+
+  argCount = argc;
+
+  for (size_t i = 0; i < argc; ++i)
+  {
+    memcpy(words[i], args[i].str, args[i].len);
+    words[i][args[i].len] = '\0';
+  }
+
+  return Success;
+}
+
+static task_t Rate(const Shell_Token_t args[], size_t argc, void *context)
+{
+  (void)argc;
+  (void)context;
+
+  return Shell_Unsigned(&args[0], &rate);
+}
+
+static task_t Refuse(const Shell_Token_t args[], size_t argc, void *context)
+{
+  (void)args;
+  (void)argc;
+  (void)context;
+
+  return Fail;
+}
+
+// ? "rate imu" before "rate", first match wins
+static const Shell_Command_t table[] = {
+    {"rate imu", "<hz>", 1, 1, Rate},
+    {"rate", "<hz>", 1, 1, Rate},
+    {"echo", "<words>", 0, SHELL_MAX_TOKENS - 1, Record},
+    {"stats", "", 0, 0, Record},
+    {"fail", "", 0, 0, Refuse},
+};
+
+/**
+ * @brief compare the printed text with the expected one, then forget it
+ *
+ */
+static void Expect(const char *text, const char *what, uint32_t step)
+{
+  Check(strcmp(output, text) == 0, what, step);
+
+  if (strcmp(output, text) != 0)
+    printf("  printed \"%s\", expected \"%s\"\n", output, text);
+
+  printed = 0;
+  output[0] = '\0';
+}
+
+static task_t Feed(Shell_DS *const shell, const char *text)
+{
+  return Shell_Feed(shell, (const uint8_t *)text, strlen(text));
+}
+
+int main(void)
+{
+  Shell_DS *shell = Shell_Constructor(table, sizeof(table) / sizeof(table[0]), Print, 0);
+
+  Check(Shell_Constructor(table, 0, Print, 0) == 0, "empty table taken", 0);
+
+  // tokenizer: spaces & tabs in any number, arguments point into the line
+  argCount = 99;
+  Check(Feed(shell, "  echo\tone  two\t\tthree \r\n") == Success, "echo failed", 1);
+  Expect("ok\r\n", "echo answer", 1);
+  Check(argCount == 3 && strcmp(words[0], "one") == 0 && strcmp(words[1], "two") == 0 && strcmp(words[2], "three") == 0, "echo arguments", 1);
+
+  Check(Feed(shell, "echo\n") == Success && argCount == 0, "echo without arguments", 2);
+  Expect("ok\r\n", "echo answer", 2);
+
+  // multi-word names, the longer one first, a word only matches as a whole
+  Check(Feed(shell, "rate imu 416\r") == Success && rate == 416, "rate imu", 3);
+  Expect("ok\r\n", "rate imu answer", 3);
+
+  Check(Feed(shell, "rate 50\r") == Success && rate == 50, "rate", 4);
+  Expect("ok\r\n", "rate answer", 4);
+
+  Check(Feed(shell, "rate imus 10\r") == Fail && rate == 50, "\"imus\" taken as \"imu\"", 5);
+  Expect("usage: rate <hz>\r\n", "rate imus answer", 5);
+
+  Check(Feed(shell, "ech\r") == Fail, "prefix of a name taken", 6);
+  Expect("unknown command, try help\r\n", "prefix answer", 6);
+
+  // line split over feeds, "\r\n" & empty lines run nothing
+  Check(Feed(shell, "ra") == Success && Feed(shell, "te im") == Success && Feed(shell, "u 1") == Success, "partial line run", 7);
+  Expect("", "partial line answer", 7);
+  Check(Feed(shell, "2\r") == Success && rate == 12, "split line", 7);
+  Expect("ok\r\n", "split line answer", 7);
+
+  Check(Feed(shell, "\r\n\r\n   \n\t\r") == Success, "empty lines", 8);
+  Expect("", "empty lines answer", 8);
+
+  // two lines in one feed, both run, a failed one fails the feed
+  Check(Feed(shell, "rate 7\nfail\r\n") == Fail && rate == 7, "two lines", 9);
+  Expect("ok\r\nerror\r\n", "two lines answer", 9);
+
+  // usage errors: argument counts, not a number
+  Check(Feed(shell, "rate imu\n") == Fail, "rate imu without argument", 10);
+  Expect("usage: rate imu <hz>\r\n", "missing argument answer", 10);
+
+  Check(Feed(shell, "stats now\n") == Fail, "stats with argument", 11);
+  Expect("usage: stats\r\n", "extra argument answer", 11);
+
+  Check(Feed(shell, "rate 4294967296\n") == Fail && Feed(shell, "rate 12a\n") == Fail && rate == 7, "bad numbers", 12);
+  Expect("error\r\nerror\r\n", "bad numbers answer", 12);
+
+  Check(Feed(shell, "rate 4294967295\n") == Success && rate == 0xFFFFFFFF, "largest number", 13);
+  Expect("ok\r\n", "largest number answer", 13);
+
+  // too many words
+  Check(Feed(shell, "echo 1 2 3 4 5 6 7\n") == Success && argCount == SHELL_MAX_TOKENS - 1, "most words", 14);
+  Expect("ok\r\n", "most words answer", 14);
+
+  Check(Feed(shell, "echo 1 2 3 4 5 6 7 8\n") == Fail, "too many words", 15);
+  Expect("too many words\r\n", "too many words answer", 15);
+
+  // overflow: the whole line is dropped at its end, the next one runs
+  char line[SHELL_MAX_LINE + 8];
+  memset(line, 'x', sizeof(line));
+  memcpy(line, "rate 99 ", 8);
+  line[sizeof(line) - 1] = '\0';
+
+  Check(Feed(shell, line) == Success, "overflow before the line end", 16);
+  Check(Feed(shell, "\n") == Fail && rate == 0xFFFFFFFF, "long line", 16);
+  Expect("line too long\r\n", "long line answer", 16);
+
+  Check(Feed(shell, "rate 3\n") == Success && rate == 3, "line after overflow", 17);
+  Expect("ok\r\n", "line after overflow answer", 17);
+
+  // a line of exactly SHELL_MAX_LINE bytes still runs
+  memset(line, ' ', SHELL_MAX_LINE);
+  memcpy(line, "rate 5", 6);
+  line[SHELL_MAX_LINE] = '\n';
+  Check(Shell_Feed(shell, (const uint8_t *)line, SHELL_MAX_LINE + 1) == Success && rate == 5, "full line", 18);
+  Expect("ok\r\n", "full line answer", 18);
+
+  // help lists the table in order
+  Check(Feed(shell, "help\n") == Success, "help", 19);
+  Expect("rate imu <hz>\r\nrate <hz>\r\necho <words>\r\nstats\r\nfail\r\n", "help answer", 19);
+
+  Shell_Destructor(shell);
+
+  printf("%s, %d failures\n", failures ? "FAIL" : "PASS", failures);
+
+  return failures;
+}
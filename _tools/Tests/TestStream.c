@@ -0,0 +1,137 @@
+/**
+ * @brief delta streams of Telemetry.c: values restored exactly across drops & corruption, size against whole values
+ *
+ */
+
+#include <stdio.h>
+
+#include "Telemetry.h"
+
+#define FRAMES 2000
+#define INTERVAL 16     // * keyframe interval of the attitude stream in projects/RangeFinder
+#define STEP 2403       // * us between two frames, about 416 Hz
+#define ORIGIN 0xFFFF0000U // * timestamp of the first frame, the counter crosses zero
+
+static uint8_t wire[FRAMES * TELEMETRY_MAX_FRAME];
+static size_t length;
+static int failures;
+
+static void Check(bool_t isPassed, const char *what, uint32_t frame)
+{
+  if (isPassed)
+    return;
+
+  failures++;
+  printf("frame %u: %s\n", frame, what);
+}
+
+/**
+ * @brief values of a frame: roll & pitch wander slowly, the timestamp is the key of the frame
+ *
+ */
+static void Values(uint32_t frame, sint32_t values[3])
+{
+  values[0] = (sint32_t)((frame * 7) % 200) - 100;
+  values[1] = 4500 + (sint32_t)((frame * 13) % 50);
+  values[2] = (sint32_t)(ORIGIN + frame * STEP);
+}
+
+static bool_t isDropped(uint32_t frame)
+{
+  return (frame == 300 || frame == 1201) ? True : False;
+}
+
+/**
+ * @brief send every frame as the app does, a frame without room forces a keyframe next
+ *
+ * @return size_t: bytes on the wire
+ */
+static size_t Send(uint16_t interval)
+{
+  Telemetry_DS *telemetry = Telemetry_Constructor();
+  Telemetry_Stream_DS *stream = Telemetry_Stream_Constructor(3, interval);
+  Buffer_DS *tx = Buffer_Constructor(TELEMETRY_MAX_FRAME);
+  Buffer_DS *small = Buffer_Constructor(2);
+  volatile uint8_t byte = 0;
+
+  length = 0;
+
+  for (uint32_t i = 0; i < FRAMES; ++i)
+  {
+    sint32_t values[3];
+    Values(i, values);
+
+    Telemetry_Stream_Encode(stream, telemetry, 0x01, values);
+
+    if (Telemetry_End(telemetry, isDropped(i) ? small : tx) != Success)
+    {
+      Telemetry_Stream_Reset(stream);
+      continue;
+    }
+
+    while (Buffer_Take(tx, &byte) == Success)
+      wire[length++] = byte;
+  }
+
+  Buffer_Destructor(small);
+  Buffer_Destructor(tx);
+  Telemetry_Stream_Destructor(stream);
+  Telemetry_Destructor(telemetry);
+
+  return length;
+}
+
+int main(void)
+{
+  const size_t whole = Send(1);
+  const size_t delta = Send(INTERVAL);
+
+  // ? one byte flipped in frame 1501, the stream waits for the next keyframe if it was a delta
+  size_t frames = 0, corrupted = 0;
+  for (size_t n = 0; n < length; ++n)
+    if (wire[n] == 0x00 && ++frames == 1500)
+      corrupted = n + 3;
+  wire[corrupted] ^= 0x01;
+
+  Telemetry_Decoder_DS decoder;
+  Telemetry_Stream_DS *stream = Telemetry_Stream_Constructor(3, INTERVAL);
+  uint32_t restored = 0, skipped = 0;
+
+  Telemetry_Decoder_Init(&decoder);
+
+  for (size_t n = 0; n < length; ++n)
+  {
+    if (Telemetry_Decode(&decoder, wire[n]) != Success)
+      continue;
+
+    size_t offset = TELEMETRY_HEADER;
+    sint32_t values[3], sent[3];
+
+    if (Telemetry_Stream_Decode(stream, &decoder, &offset, values) != Success)
+    {
+      skipped++;
+      continue;
+    }
+
+    const uint32_t frame = ((uint32_t)values[2] - ORIGIN) / STEP;
+    Values(frame, sent);
+
+    Check(frame < FRAMES && !isDropped(frame), "restored out of nowhere", frame);
+    Check(values[0] == sent[0] && values[1] == sent[1] && values[2] == sent[2], "restored values differ", frame);
+
+    restored++;
+  }
+
+  printf("restored %u, skipped %u, lost %u, corrupted %u\n", restored, skipped, decoder.lost, decoder.corrupted);
+  printf("bytes per frame: %.1f delta coded, %.1f whole values\n", (double)delta / (FRAMES - 2), (double)whole / (FRAMES - 2));
+
+  Check(decoder.corrupted == 1 && decoder.lost == 3, "counts of the decoder", FRAMES);
+  Check(restored + skipped == FRAMES - 3 && skipped > 0 && skipped < INTERVAL * 3, "frames waiting for a keyframe", FRAMES);
+  Check(delta < whole, "delta coding saves nothing", FRAMES);
+
+  Telemetry_Stream_Destructor(stream);
+
+  printf("%s, %d failures\n", failures ? "FAIL" : "PASS", failures);
+
+  return failures;
+}
@@ -0,0 +1,104 @@
+/**
+ * @brief COBS & CRC-16 round trip of Telemetry.c: frames dropped for room or corrupted on the wire are counted
+ *
+ */
+
+#include <stdio.h>
+
+#include "Telemetry.h"
+
+#define FRAMES 1000
+#define DROPPED 500   // * frame without room in the TX buffer, its sequence is used up
+#define CORRUPTED 700 // * frame with one byte flipped on the wire
+
+static uint8_t wire[FRAMES * TELEMETRY_MAX_FRAME];
+static size_t length;
+static int failures;
+
+static void Check(bool_t isPassed, const char *what, uint32_t frame)
+{
+  if (isPassed)
+    return;
+
+  failures++;
+  printf("frame %u: %s\n", frame, what);
+}
+
+static void Drain(Buffer_DS *const buffer)
+{
+  volatile uint8_t byte = 0;
+
+  while (Buffer_Take(buffer, &byte) == Success)
+    wire[length++] = byte;
+}
+
+int main(void)
+{
+  Telemetry_DS *telemetry = Telemetry_Constructor();
+  Buffer_DS *tx = Buffer_Constructor(TELEMETRY_MAX_FRAME);
+  Buffer_DS *small = Buffer_Constructor(4);
+  Telemetry_Decoder_DS decoder;
+
+  for (uint32_t i = 0; i < FRAMES; ++i)
+  {
+    Telemetry_Begin(telemetry, 0x01);
+    Telemetry_Unsigned(telemetry, i);
+    Telemetry_Signed(telemetry, -(sint32_t)i * 1000);
+    Telemetry_Unsigned(telemetry, i * 2654435761U);
+
+    if (i == DROPPED)
+    {
+      Check(Telemetry_End(telemetry, small) == Fail && Buffer_Length(small) == 0, "not refused as a whole", i);
+      continue;
+    }
+
+    const size_t start = length;
+
+    Check(Telemetry_End(telemetry, tx) == Success, "not sent", i);
+    Drain(tx);
+
+    // ? a byte in the middle of the fields, never the delimiter
+    if (i == CORRUPTED)
+      wire[start + (length - start) / 2] ^= 0x10;
+  }
+
+  Telemetry_Decoder_Init(&decoder);
+
+  uint32_t expected = 0;
+
+  for (size_t n = 0; n < length; ++n)
+  {
+    if (Telemetry_Decode(&decoder, wire[n]) != Success)
+      continue;
+
+    while (expected == DROPPED || expected == CORRUPTED)
+      expected++;
+
+    size_t offset = TELEMETRY_HEADER;
+    uint32_t index = 0, hash = 0;
+    sint32_t value = 0;
+
+    const bool_t isRead =
+        Telemetry_ReadUnsigned(decoder.frame, decoder.len, &offset, &index) == Success &&
+        Telemetry_ReadSigned(decoder.frame, decoder.len, &offset, &value) == Success &&
+        Telemetry_ReadUnsigned(decoder.frame, decoder.len, &offset, &hash) == Success;
+
+    Check(isRead, "fields missing", expected);
+    Check(decoder.frame[1] == (uint8_t)expected, "wrong sequence", expected);
+    Check(index == expected && value == -(sint32_t)expected * 1000 && hash == expected * 2654435761U, "wrong fields", expected);
+
+    expected++;
+  }
+
+  printf("frames %u, lost %u, corrupted %u\n", decoder.frames, decoder.lost, decoder.corrupted);
+
+  Check(decoder.frames == FRAMES - 2 && decoder.lost == 2 && decoder.corrupted == 1, "counts of the decoder", FRAMES);
+
+  Buffer_Destructor(small);
+  Buffer_Destructor(tx);
+  Telemetry_Destructor(telemetry);
+
+  printf("%s, %d failures\n", failures ? "FAIL" : "PASS", failures);
+
+  return failures;
+}
@@ -65,7 +65,7 @@ extern "C"
    * @brief peek the index data of buffer
    *
    * @param self: object pointer
-   * @param index: order
+   * @param index: order from the head
    * @param byte: data to save result
    * @return task_t: Success / Fail
    */
@@ -87,6 +87,44 @@ extern "C"
    */
   size_t Buffer_Length(Buffer_DS *const self);
 
+  /**
+   * @brief get free bytes left in buffer
+   *
+   * @param self: object pointer
+   * @return size_t: size - current length
+   */
+  size_t Buffer_Space(Buffer_DS *const self);
+
+  /**
+   * @brief get the contiguous bytes from the head, e.g. for one DMA transfer
+   * @warning bytes stay in buffer until Buffer_Skip()
+   *
+   * @param self: object pointer
+   * @param region: save address of the head
+   * @return size_t: contiguous length, the rest (if any) starts from the front of the array
+   */
+  size_t Buffer_Region(Buffer_DS *const self, const uint8_t **const region);
+
+  /**
+   * @brief drop bytes from the head, e.g. after the DMA transfer of a region
+   *
+   * @param self: object pointer
+   * @param len: bytes to drop
+   * @return task_t: Success / Fail
+   */
+  task_t Buffer_Skip(Buffer_DS *const self, const size_t len);
+
+  /**
+   * @brief remove bytes from the middle, the bytes after them move toward the head
+   * @warning bytes before index are untouched, e.g. a region in DMA flight
+   *
+   * @param self: object pointer
+   * @param index: order from the head of the first byte to remove
+   * @param len: bytes to remove
+   * @return task_t: Success / Fail (out of the current length)
+   */
+  task_t Buffer_Cut(Buffer_DS *const self, const size_t index, const size_t len);
+
   /**
    * @brief check for items at the ends of buffer
    *
@@ -14,6 +14,21 @@ extern "C"
 #include "stm32f103xe.h"
 #elif defined(STM32F103xF) || defined(STM32F103xG)
 #include "stm32f103xg.h"
+#elif defined(HOST_TOOLS)
+// ? host side tools (e.g. _tools/Telemetry) share the device independent sources
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef HOST_DEVICE
+// ? register model of the peripherals a host test drives (e.g. _tools/Tests/HostDevice.h)
+#include "HostDevice.h"
+#else
+// ? register block of a port, host tests read the pins back from it
+typedef struct
+{
+  volatile uint32_t CRL, CRH, IDR, ODR, BSRR, BRR, LCKR;
+} GPIO_TypeDef;
+#endif // HOST_DEVICE
 #else
 #define STM32F103xx_UNREADY
 #warning "This library must be working under stm32f103xx series"
@@ -32,19 +47,31 @@ extern "C"
    * @brief
    *
    */
+#ifndef HOST_TOOLS
   typedef unsigned char uint8_t;
   typedef unsigned short uint16_t;
   typedef unsigned int uint32_t;
+#endif // HOST_TOOLS
 
   typedef signed char sint8_t;
   typedef signed short sint16_t;
   typedef signed int sint32_t;
 
+#ifndef HOST_TOOLS
+  typedef unsigned long long uint64_t;
+#endif // HOST_TOOLS
+  typedef signed long long sint64_t;
+
+  typedef sint16_t q15_t; // * fixed-point, 15 fractional bits
+  typedef sint32_t q31_t; // * fixed-point, container of Q31 / Q30 / Q16 ...
+
   typedef unsigned char flag8_t;
   typedef unsigned short flag16_t;
   typedef unsigned int flag32_t;
 
+#ifndef HOST_TOOLS
   typedef unsigned int size_t;
+#endif // HOST_TOOLS
 
   typedef enum
   {
@@ -64,6 +91,23 @@ extern "C"
     uint8_t order; // 0 ~ 15
   } port_t;
 
+#if !defined(HOST_TOOLS) || defined(HOST_DEVICE)
+
+  /**
+   * @brief APB clock from the live clock tree ( SystemCoreClock is HCLK )
+   *
+   * @param isAPB2: APB2 ( SPI1, USART1 ... ) or APB1 ( SPI2, USART2, USART3 ... )
+   * @return uint32_t: frequency in Hz
+   */
+  static inline uint32_t _APBClock(bool_t isAPB2)
+  {
+    // RCC_CFGR PPRE1 [10:8] / PPRE2 [13:11]: 0xx -> /1, 100 -> /2 ... 111 -> /16
+    const flag32_t ppre = _MASK(RCC->CFGR >> (isAPB2 ? 11 : 8), 0x07);
+
+    return _MASK(ppre, 0x04) ? (SystemCoreClock >> (_MASK(ppre, 0x03) + 1)) : SystemCoreClock;
+  }
+#endif // HOST_TOOLS & HOST_DEVICE
+
 #endif // STM32F103xx_UNREADY
 
 #ifdef __cplusplus
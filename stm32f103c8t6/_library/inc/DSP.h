@@ -0,0 +1,284 @@
+/**
+ * @file DSP.h
+ * @author Zhang, Zhen Yu (https://github.com/TooLateToDieYoung)
+ * @brief
+ * | Q15 signal processing kernels for sensor streams. \n
+ * | FIR, biquad IIR, moving average, CIC decimation & block statistics. \n
+ * | All kernels work on blocks, the input is read with a stride, \n
+ * | so one axis can be taken straight from interleaved frames.
+ * @warning
+ * | Cortex-M3 has no dual 16 bits MAC (SMLAD), \n
+ * | products are accumulated in 64 bits (SMULL / SMLAL) instead.
+ * @version 0.1
+ * @date 2023-01-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef _DSP_H_
+#define _DSP_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+#include "Fusion.h"
+
+#ifndef STM32F103xx_UNREADY
+
+  /** Data Structure Begin ---------------------------------------------------------------
+   * @brief class data sturcture
+   * @warning Plz operate the object through the interface
+   *
+   */
+
+  /**
+   * @brief FIR filter
+   *
+   */
+  typedef struct
+  {
+    const q15_t *coeffs; // * Q15 b[0] ~ b[taps - 1], kept by the user
+    q15_t *state;        // * (taps - 1) history + one block
+    size_t taps;
+    size_t block; // * max samples per process
+  } DSP_FIR_DS;
+
+  /**
+   * @brief cascaded biquad IIR filter (direct form I)
+   * | y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2
+   *
+   */
+  typedef struct
+  {
+    const q15_t *coeffs; // * 5 per stage: b0, b1, b2, a1, a2 in Q(15 - shift), kept by the user
+    q15_t *state;        // * 4 per stage: x1, x2, y1, y2
+    size_t stages;
+    uint8_t shift; // * coefficient headroom, 1 -> Q14 (|coeff| < 2)
+  } DSP_Biquad_DS;
+
+  /**
+   * @brief moving average
+   *
+   */
+  typedef struct
+  {
+    q15_t *window;
+    size_t size, index, count;
+    sint32_t sum;
+  } DSP_Average_DS;
+
+  /**
+   * @brief CIC decimator
+   *
+   */
+  typedef struct
+  {
+    uint32_t integrator[4]; // * wrap around on purpose, modulo 2^32
+    uint32_t comb[4];
+    uint8_t order; // * 1 ~ 4
+    uint8_t shift; // * order * log2(ratio), gain of the filter
+    size_t ratio;  // * decimation, power of 2
+    size_t phase;
+  } DSP_CIC_DS;
+
+  /**
+   * @brief statistics of one block
+   *
+   */
+  typedef struct
+  {
+    q15_t min;
+    q15_t max;
+    q15_t mean;
+    q15_t rms;
+  } DSP_Stats_t;
+
+  /* ---------------------------------------------------------------- Data Structure End */
+
+  /** Interface Begin --------------------------------------------------------------------
+   * @brief
+   * | Almost directly through the register operation. \n
+   * | For each function, they provide an alternative, \n
+   * | with the same functionality, implemented with the LL library.
+   *
+   * @warning Do not change these codes, it may cause errors
+   */
+
+  // ? FIR ---------------------------------------------------------------------------------------
+
+  /**
+   * @brief Constructor (dynamic memory)
+   *
+   * @param coeffs: Q15 coefficients, must stay valid
+   * @param taps: length of coeffs
+   * @param block: max samples per process
+   * @return DSP_FIR_DS*: dynamic memory pointer
+   */
+  DSP_FIR_DS *DSP_FIR_Constructor(const q15_t coeffs[], size_t taps, size_t block);
+
+  /**
+   * @brief Destructor
+   *
+   * @param self: object pointer
+   * @return task_t: Success / Fail
+   */
+  task_t DSP_FIR_Destructor(DSP_FIR_DS *const self);
+
+  /**
+   * @brief clear the history
+   *
+   * @param self: object pointer
+   */
+  void DSP_FIR_Reset(DSP_FIR_DS *const self);
+
+  /**
+   * @brief filter one block
+   *
+   * @param self: object pointer
+   * @param in: first input sample
+   * @param stride: distance between input samples (1 -> contiguous)
+   * @param out: save filtered samples (contiguous)
+   * @param len: samples, up to block
+   * @return task_t: Success / Fail
+   */
+  task_t DSP_FIR_Process(DSP_FIR_DS *const self, const q15_t in[], size_t stride, q15_t out[], size_t len);
+
+  // ? Biquad ------------------------------------------------------------------------------------
+
+  /**
+   * @brief Constructor (dynamic memory)
+   *
+   * @param coeffs: 5 per stage, must stay valid
+   * @param stages: amount of cascaded stages
+   * @param shift: coefficient headroom (0 ~ 2)
+   * @return DSP_Biquad_DS*: dynamic memory pointer
+   */
+  DSP_Biquad_DS *DSP_Biquad_Constructor(const q15_t coeffs[], size_t stages, uint8_t shift);
+
+  /**
+   * @brief Destructor
+   *
+   * @param self: object pointer
+   * @return task_t: Success / Fail
+   */
+  task_t DSP_Biquad_Destructor(DSP_Biquad_DS *const self);
+
+  /**
+   * @brief clear the history
+   *
+   * @param self: object pointer
+   */
+  void DSP_Biquad_Reset(DSP_Biquad_DS *const self);
+
+  /**
+   * @brief filter one block through all stages
+   *
+   * @param self: object pointer
+   * @param in: first input sample
+   * @param stride: distance between input samples (1 -> contiguous)
+   * @param out: save filtered samples (contiguous), also the work buffer between stages
+   * @param len: samples
+   */
+  void DSP_Biquad_Process(DSP_Biquad_DS *const self, const q15_t in[], size_t stride, q15_t out[], size_t len);
+
+  // ? Moving Average ----------------------------------------------------------------------------
+
+  /**
+   * @brief Constructor (dynamic memory)
+   *
+   * @param size: window length (1 ~ 65535)
+   * @return DSP_Average_DS*: dynamic memory pointer
+   */
+  DSP_Average_DS *DSP_Average_Constructor(size_t size);
+
+  /**
+   * @brief Destructor
+   *
+   * @param self: object pointer
+   * @return task_t: Success / Fail
+   */
+  task_t DSP_Average_Destructor(DSP_Average_DS *const self);
+
+  /**
+   * @brief clear the window
+   *
+   * @param self: object pointer
+   */
+  void DSP_Average_Reset(DSP_Average_DS *const self);
+
+  /**
+   * @brief average one block, the window is partial until it is filled
+   *
+   * @param self: object pointer
+   * @param in: first input sample
+   * @param stride: distance between input samples (1 -> contiguous)
+   * @param out: save averaged samples (contiguous)
+   * @param len: samples
+   */
+  void DSP_Average_Process(DSP_Average_DS *const self, const q15_t in[], size_t stride, q15_t out[], size_t len);
+
+  // ? CIC ---------------------------------------------------------------------------------------
+
+  /**
+   * @brief Constructor (dynamic memory)
+   *
+   * @param order: 1 ~ 4
+   * @param ratio: decimation, power of 2 with order * log2(ratio) <= 16
+   * @return DSP_CIC_DS*: dynamic memory pointer
+   */
+  DSP_CIC_DS *DSP_CIC_Constructor(uint8_t order, size_t ratio);
+
+  /**
+   * @brief Destructor
+   *
+   * @param self: object pointer
+   * @return task_t: Success / Fail
+   */
+  task_t DSP_CIC_Destructor(DSP_CIC_DS *const self);
+
+  /**
+   * @brief clear integrators, combs & phase
+   *
+   * @param self: object pointer
+   */
+  void DSP_CIC_Reset(DSP_CIC_DS *const self);
+
+  /**
+   * @brief decimate one block, the gain is removed
+   *
+   * @param self: object pointer
+   * @param in: first input sample
+   * @param stride: distance between input samples (1 -> contiguous)
+   * @param len: input samples
+   * @param out: save decimated samples (contiguous)
+   * @param capacity: length of out, len / ratio + 1 is always enough
+   * @param count: save amount of decimated samples
+   * @return task_t: Success / Fail (out is full)
+   */
+  task_t DSP_CIC_Process(DSP_CIC_DS *const self, const q15_t in[], size_t stride, size_t len, q15_t out[], size_t capacity, size_t *const count);
+
+  // ? Statistics --------------------------------------------------------------------------------
+
+  /**
+   * @brief min, max, mean & RMS of one block
+   *
+   * @param in: first input sample
+   * @param stride: distance between input samples (1 -> contiguous)
+   * @param len: samples
+   * @param stats: save statistics
+   * @return task_t: Success / Fail (empty block)
+   */
+  task_t DSP_Stats(const q15_t in[], size_t stride, size_t len, DSP_Stats_t *const stats);
+
+  /* ---------------------------------------------------------------- Interface Code End */
+
+#endif // STM32F103xx_UNREADY
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // _DSP_H_
@@ -0,0 +1,142 @@
+/**
+ * @file Display.h
+ * @author Zhang, Zhen Yu (https://github.com/TooLateToDieYoung)
+ * @brief
+ * | Multiplexed seven segment display of N digits sharing the segment pins. \n
+ * | Glyphs are written into a back buffer, Display_Show() swaps it with the front one, \n
+ * | Display_Scan() lights one digit of the front buffer per timer interrupt.
+ * @warning
+ * | Only one thread writes the back buffer, Display_Scan() belongs to one interrupt.
+ * @version 0.1
+ * @date 2023-01-23
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef _DISPLAY_H_
+#define _DISPLAY_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+#include "SevenSegment.h"
+
+#ifndef STM32F103xx_UNREADY
+
+  /** Def. Begin -------------------------------------------------------------------------
+   * @brief
+   *
+   */
+
+#define DISPLAY_BLANK 0x00 // * glyph of a dark digit
+
+  /* -------------------------------------------------------------------------- Def. End */
+
+  /** Data Structure Begin ---------------------------------------------------------------
+   * @brief class data sturcture
+   * @warning Plz operate the object through the interface
+   *
+   */
+
+  typedef struct
+  {
+
+    SevenSegment_DS **digit; // * position 0 is the rightmost digit
+    size_t count;            // * digits, e.g. 3, 4 or 8
+
+    flag8_t *frame;           // * 2 * count glyphs, both buffers
+    flag8_t *volatile front;  // * read by Display_Scan(), replaced in one word write
+    flag8_t *back;            // * written by the user
+    volatile size_t position; // * digit lit by the last scan
+
+  } Display_DS;
+
+  /* ---------------------------------------------------------------- Data Structure End */
+
+  /** Interface Begin --------------------------------------------------------------------
+   * @brief
+   * | Almost directly through the register operation. \n
+   * | For each function, they provide an alternative, \n
+   * | with the same functionality, implemented with the LL library.
+   *
+   * @warning Do not change these codes, it may cause errors
+   */
+
+  /**
+   * @brief Constructor (dynamic memory)
+   *
+   * @param common: common anode pins, [0] is the rightmost digit
+   * @param count: length of common
+   * @param io: segment pins shared by all digits, [7:0] stand to SegP to SegA
+   * @return Display_DS*: dynamic memory pointer, all digits blank
+   */
+  Display_DS *Display_Constructor(const port_t common[], size_t count, const port_t io[]);
+
+  /**
+   * @brief Destructor
+   *
+   * @param self: object pointer
+   * @return task_t: Success / Fail
+   */
+  task_t Display_Destructor(Display_DS *const self);
+
+  /**
+   * @brief write a raw glyph into the back buffer
+   *
+   * @param self: object pointer
+   * @param position: 0 is the rightmost digit
+   * @param glyph: SevenSegmentIndex_Enum combined, e.g. Num7 | SegP
+   * @return task_t: Success / Fail (no such digit)
+   */
+  task_t Display_Glyph(Display_DS *const self, size_t position, flag8_t glyph);
+
+  /**
+   * @brief write a hex digit into the back buffer
+   *
+   * @param self: object pointer
+   * @param position: 0 is the rightmost digit
+   * @param value: 0x0 to 0xF
+   * @param isPoint: light SegP of the digit
+   * @return task_t: Success / Fail (no such digit or value)
+   */
+  task_t Display_Digit(Display_DS *const self, size_t position, uint8_t value, bool_t isPoint);
+
+  /**
+   * @brief write a decimal number into the back buffer, leading zeros kept
+   *
+   * @param self: object pointer
+   * @param value: lowest digit at position 0, higher digits than count are cut
+   * @param point: position of SegP, count or more -> none
+   * @return task_t: Success / Fail
+   */
+  task_t Display_Unsigned(Display_DS *const self, uint32_t value, size_t point);
+
+  /**
+   * @brief swap the buffers, the next scan shows the new frame
+   * | The new back buffer is a copy of the frame shown, only the digits to change need a write.
+   * @warning from the writer thread only, not from the interrupt of Display_Scan()
+   *
+   * @param self: object pointer
+   * @return task_t: Success / Fail
+   */
+  task_t Display_Show(Display_DS *const self);
+
+  /**
+   * @brief switch the lit digit off & light the next one, call from a timer interrupt
+   *
+   * @param self: object pointer
+   */
+  void Display_Scan(Display_DS *const self);
+
+  /* ---------------------------------------------------------------- Interface Code End */
+
+#endif // STM32F103xx_UNREADY
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // _DISPLAY_H_
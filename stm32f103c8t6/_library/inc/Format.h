@@ -0,0 +1,121 @@
+/**
+ * @file Format.h
+ * @author Zhang, Zhen Yu (https://github.com/TooLateToDieYoung)
+ * @brief
+ * | Number to text without printf: integers, fixed point, hex & padding. \n
+ * | Text goes into a span of the caller, or all or nothing into a Buffer_DS. \n
+ * | Division by 10 is a reciprocal multiplication (UMULL), no UDIV loop.
+ * @warning
+ * | No dynamic memory, no state: safe from any context.
+ * @version 0.1
+ * @date 2023-01-23
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef _FORMAT_H_
+#define _FORMAT_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+#include "Buffer.h"
+
+#ifndef STM32F103xx_UNREADY
+
+  /** Def. Begin -------------------------------------------------------------------------
+   * @brief
+   *
+   */
+
+#define FORMAT_MAX_TEXT 16 // * longest text of one number: sign, 10 digits & point, or width
+
+  /* -------------------------------------------------------------------------- Def. End */
+
+  /** Interface Begin --------------------------------------------------------------------
+   * @brief
+   * | Almost directly through the register operation. \n
+   * | For each function, they provide an alternative, \n
+   * | with the same functionality, implemented with the LL library.
+   *
+   * @warning Do not change these codes, it may cause errors
+   */
+
+  /**
+   * @brief quotient & remainder of a division by 10, exact for every uint32_t
+   *
+   * @param value: dividend
+   * @param digit: save the remainder (0 ~ 9), NULL -> not needed
+   * @return uint32_t: value / 10
+   */
+  uint32_t Format_Div10(uint32_t value, uint8_t *const digit);
+
+  /**
+   * @brief unsigned decimal
+   *
+   * @param str: span to write, not terminated
+   * @param size: length of str
+   * @param value: number
+   * @param width: min characters, padded on the left (0: none)
+   * @param pad: ' ' or '0'
+   * @return size_t: characters written, 0 -> not enough space (nothing written)
+   */
+  size_t Format_Unsigned(uint8_t str[], size_t size, uint32_t value, size_t width, uint8_t pad);
+
+  /**
+   * @brief signed decimal, '0' padding goes after the sign
+   *
+   * @param str: span to write, not terminated
+   * @param size: length of str
+   * @param value: number
+   * @param width: min characters, padded on the left (0: none)
+   * @param pad: ' ' or '0'
+   * @return size_t: characters written, 0 -> not enough space (nothing written)
+   */
+  size_t Format_Signed(uint8_t str[], size_t size, sint32_t value, size_t width, uint8_t pad);
+
+  /**
+   * @brief fixed point decimal, e.g. 0.01 degree: -1234, 2 -> "-12.34"
+   *
+   * @param str: span to write, not terminated
+   * @param size: length of str
+   * @param value: number in units of 10^-decimals
+   * @param decimals: digits after the point (0 ~ 9, 0: integer)
+   * @param width: min characters, padded on the left with ' ' (0: none)
+   * @return size_t: characters written, 0 -> not enough space or illegal decimals (nothing written)
+   */
+  size_t Format_Fixed(uint8_t str[], size_t size, sint32_t value, uint8_t decimals, size_t width);
+
+  /**
+   * @brief upper case hex, without prefix
+   *
+   * @param str: span to write, not terminated
+   * @param size: length of str
+   * @param value: number
+   * @param digits: min digits, padded with '0' (0: none)
+   * @return size_t: characters written, 0 -> not enough space (nothing written)
+   */
+  size_t Format_Hex(uint8_t str[], size_t size, uint32_t value, size_t digits);
+
+  /**
+   * @brief append text to a buffer, all or nothing
+   *
+   * @param buffer: e.g. TX buffer of HC05
+   * @param str: text, from one of the functions above
+   * @param len: length of str (0: nothing to do, Fail)
+   * @return task_t: Success / Fail (not enough space, nothing written)
+   */
+  task_t Format_Push(Buffer_DS *const buffer, const uint8_t str[], size_t len);
+
+  /* ---------------------------------------------------------------- Interface Code End */
+
+#endif // STM32F103xx_UNREADY
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // _FORMAT_H_
@@ -0,0 +1,170 @@
+/**
+ * @file Fusion.h
+ * @author Zhang, Zhen Yu (https://github.com/TooLateToDieYoung)
+ * @brief
+ * | Integer-only attitude filter for 6-axis IMU frames. \n
+ * | Mahony nonlinear complementary filter on a Q30 quaternion, \n
+ * | ki = 0 turns it into a plain complementary filter (no gyro bias integral).
+ * @warning
+ * @version 0.1
+ * @date 2023-01-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef _FUSION_H_
+#define _FUSION_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+#include "Common.h"
+
+#ifndef STM32F103xx_UNREADY
+
+  /** Def. Begin -------------------------------------------------------------------------
+   * @brief
+   *
+   */
+
+#define FUSION_ONE_Q30 0x40000000 // * 1.0 in Q30
+#define FUSION_ONE_Q16 0x00010000 // * 1.0 in Q16
+
+  /* -------------------------------------------------------------------------- Def. End */
+
+  /** Data Structure Begin ---------------------------------------------------------------
+   * @brief class data sturcture
+   * @warning Plz operate the object through the interface
+   *
+   */
+
+  /**
+   * @brief filter configuration
+   *
+   */
+  typedef struct
+  {
+    uint32_t gyroScale; // * gyro sensitivity in udps / LSB (8750 for +-245 dps)
+    q31_t kp;           // * Q16, proportional gain ( 2.0 -> 2 * FUSION_ONE_Q16 )
+    q31_t ki;           // * Q16, integral gain, 0 -> complementary filter
+  } Fusion_Config_t;
+
+  typedef struct
+  {
+
+    q31_t q[4]; // * Q30 quaternion: w, x, y, z
+
+    q31_t integral[3]; // * Q15 rad/s, gyro bias estimate
+
+    uint32_t step; // * Q56 half rad per LSB per us
+
+    q31_t kp, ki; // * Q16
+
+    struct
+    {
+      uint32_t last, max; // * DWT cycles of Fusion_Update()
+    } cycles;
+
+  } Fusion_DS;
+
+  /* ---------------------------------------------------------------- Data Structure End */
+
+  /** Interface Begin --------------------------------------------------------------------
+   * @brief
+   * | Almost directly through the register operation. \n
+   * | For each function, they provide an alternative, \n
+   * | with the same functionality, implemented with the LL library.
+   *
+   * @warning Do not change these codes, it may cause errors
+   */
+
+  /**
+   * @brief Constructor (dynamic memory)
+   * @warning DWT cycle counter is enabled for the cycle budget
+   *
+   * @param config: filter configuration
+   * @return Fusion_DS*: dynamic memory pointer
+   */
+  Fusion_DS *Fusion_Constructor(const Fusion_Config_t *const config);
+
+  /**
+   * @brief Destructor
+   *
+   * @param self: object pointer
+   * @return task_t: Success / Fail
+   */
+  task_t Fusion_Destructor(Fusion_DS *const self);
+
+  /**
+   * @brief back to the identity attitude & clear the bias estimate
+   *
+   * @param self: object pointer
+   */
+  void Fusion_Reset(Fusion_DS *const self);
+
+  /**
+   * @brief feed one frame of raw counts
+   * @warning acce is only used for its direction, any full-scale works
+   *
+   * @param self: object pointer
+   * @param gyro: X, Y, Z raw counts
+   * @param acce: X, Y, Z raw counts, all 0 -> gyro only
+   * @param dt: time since the last frame in us (1 ~ 1000000)
+   * @return task_t: Success / Fail
+   */
+  task_t Fusion_Update(Fusion_DS *const self, const sint16_t gyro[3], const sint16_t acce[3], uint32_t dt);
+
+  /**
+   * @brief get the attitude
+   *
+   * @param self: object pointer
+   * @param q: save Q30 quaternion (w, x, y, z)
+   */
+  void Fusion_GetQuaternion(Fusion_DS *const self, q31_t q[4]);
+
+  /**
+   * @brief get roll & pitch
+   *
+   * @param self: object pointer
+   * @param roll: save roll in 0.01 degree (-18000 ~ 18000)
+   * @param pitch: save pitch in 0.01 degree (-9000 ~ 9000)
+   */
+  void Fusion_GetEuler(Fusion_DS *const self, sint16_t *const roll, sint16_t *const pitch);
+
+  /**
+   * @brief get the gravity direction in the sensor frame
+   *
+   * @param self: object pointer
+   * @param gravity: save Q15 unit vector X, Y, Z
+   */
+  void Fusion_GetGravity(Fusion_DS *const self, q15_t gravity[3]);
+
+  /**
+   * @brief atan2 in 0.01 degree, max error about 0.1 degree
+   *
+   * @param y: same unit as x, |y| < 2^16
+   * @param x: same unit as y, |x| < 2^16
+   * @return sint16_t: -18000 ~ 18000
+   */
+  sint16_t Fusion_Atan2(sint32_t y, sint32_t x);
+
+  /**
+   * @brief integer square root
+   *
+   * @param n: radicand
+   * @return uint32_t: floor(sqrt(n))
+   */
+  uint32_t Fusion_Sqrt(uint32_t n);
+
+  /* ---------------------------------------------------------------- Interface Code End */
+
+#endif // STM32F103xx_UNREADY
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // _FUSION_H_
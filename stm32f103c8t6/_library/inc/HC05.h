@@ -19,20 +19,76 @@ extern "C"
 #endif // __cplusplus
 
 #include "InterfaceUSART.h"
+#include "InterfaceDMA.h"
+#include "Buffer.h"
 
 #ifndef STM32F103xx_UNREADY
 
+  /** Def. Begin -------------------------------------------------------------------------
+   * @brief
+   *
+   */
+
+#define HC05_BAUD_MIN 9600    // * lowest rate of AT+UART
+#define HC05_BAUD_MAX 1382400 // * highest rate of AT+UART
+#define HC05_AT_BAUD 38400    // * fixed rate of the full AT mode (KEY high at power-up)
+
+#define HC05_TX_MARKS 16 // * messages told apart in the TX buffer, more are merged into the last one
+
+  /* -------------------------------------------------------------------------- Def. End */
+
   /** Data Structure Begin ---------------------------------------------------------------
    * @brief class data sturcture
    * @warning Plz operate the object through the interface
    *
    */
 
+  /**
+   * @brief what to give up when the TX buffer is full, e.g. the module holds CTS
+   *
+   */
+  typedef enum
+  {
+    HC05_DROP_NEWEST = 0, // * the new message is refused
+    HC05_DROP_OLDEST,     // * whole messages not started by the DMA are removed, oldest first
+    HC05_BLOCK            // * wait for the DMA to free room, up to the try times of the caller
+  } HC05_Policy_Enum;
+
   typedef struct
   {
 
     USART_TypeDef *USARTx;
 
+    DMA_TypeDef *DMAx; // * DMA controller
+
+    uint32_t baud; // * bit/s of the USART
+
+    struct
+    {
+      DMA_Channel_TypeDef *channel;
+      uint8_t order;
+      Buffer_DS *buffer;      // * bytes queued for DMA, NULL -> not attached
+      volatile size_t length; // * bytes of the region in flight
+      volatile bool_t isBusy;
+      size_t marks[HC05_TX_MARKS]; // * lengths of the queued messages, oldest first
+      size_t first, count;         // * ring of marks
+      size_t marked;               // * bytes of all marks, the DMA never goes past them
+      size_t done;                 // * bytes of the oldest message already handed to the DMA
+      uint32_t dropped;            // * messages removed by HC05_DROP_OLDEST
+    } tx;
+
+    struct
+    {
+      DMA_Channel_TypeDef *channel;
+      uint8_t order;
+      uint8_t *array;          // * ring written by the circular DMA, NULL -> not attached
+      size_t size;             // * length of array
+      size_t last;             // * DMA position at the last collect
+      volatile size_t pending; // * bytes not received by the user yet
+      volatile bool_t isFrame; // * idle line seen, a frame is complete
+      volatile bool_t isOverrun;
+    } rx;
+
   } HC05_DS;
 
   /* ---------------------------------------------------------------- Data Structure End */
@@ -82,6 +138,179 @@ extern "C"
    */
   task_t HC05_RxByte(HC05_DS *const self, volatile uint8_t *byte, uint16_t timeout);
 
+  /**
+   * @brief switch the USART to another rate, the module is not told
+   * @warning the last byte is waited out, DMA transfers in flight break
+   *
+   * @param self: object pointer
+   * @param baud: bit/s
+   * @return task_t: Success / Fail (out of range of the APB clock)
+   */
+  task_t HC05_SetBaud(HC05_DS *const self, uint32_t baud);
+
+  /**
+   * @brief send an AT command & wait for its OK (polling)
+   * @warning the module answers in AT mode only (KEY high), \n
+   * | call it before the DMA channels are attached
+   *
+   * @param self: object pointer
+   * @param cmd: command without the line end (e.g. "AT+NAME?")
+   * @param len: length of cmd
+   * @param timeout: set try times of each byte
+   * @return task_t: Success / Fail (ERROR, FAIL, silence or garbage)
+   */
+  task_t HC05_Command(HC05_DS *const self, const uint8_t cmd[], size_t len, uint32_t timeout);
+
+  /**
+   * @brief set the data mode rate of the module (AT+UART & AT+RESET at HC05_AT_BAUD), the USART follows it
+   * | The module saves AT+UART itself, so the rate survives power cycles.
+   * @warning full AT mode only: KEY high at power-up, released before AT+RESET, \n
+   * | call it before the DMA channels are attached, the new rate is not checked
+   *
+   * @param self: object pointer
+   * @param baud: bit/s, one of the rates of AT+UART (HC05_BAUD_MIN ~ HC05_BAUD_MAX)
+   * @param timeout: set try times of each byte
+   * @return task_t: Success / Fail (unknown rate or no OK, the USART is restored)
+   */
+  task_t HC05_SetModuleBaud(HC05_DS *const self, uint32_t baud, uint32_t timeout);
+
+  /**
+   * @brief RTS / CTS hardware flow control (USART1: PA11 CTS, PA12 RTS), off after reset
+   * | CTS high holds the next byte, RTS goes high while a received byte is not read.
+   * @warning the last byte is waited out, GPIO of the pins is left to the user, \n
+   * | the pins must be wired to the module: CTS left floating may hold TX forever
+   *
+   * @param self: object pointer
+   * @param isEnabled: True / False
+   * @return task_t: Success / Fail
+   */
+  task_t HC05_SetFlowControl(HC05_DS *const self, bool_t isEnabled);
+
+  /**
+   * @brief send through the TX DMA channel from a buffer (USART1 ch4, USART2 ch7, USART3 ch2)
+   * @warning TXE interrupt must stay off, NVIC of the channel is left to the user
+   *
+   * @param self: object pointer
+   * @param buffer: queue of the bytes to send, owned by the user
+   * @return task_t: Success / Fail
+   */
+  task_t HC05_AttachTx(HC05_DS *const self, Buffer_DS *const buffer);
+
+  /**
+   * @brief queue bytes & start the DMA if it is idle, HC05_DROP_NEWEST
+   *
+   * @param self: object pointer
+   * @param array: bytes to send
+   * @param len: length of array
+   * @return task_t: Success / Fail (not attached or not enough space, nothing queued)
+   */
+  task_t HC05_Send(HC05_DS *const self, const uint8_t array[], size_t len);
+
+  /**
+   * @brief queue one message by a policy & start the DMA if it is idle
+   *
+   * @param self: object pointer
+   * @param array: bytes to send
+   * @param len: length of array
+   * @param policy: refer to HC05_Policy_Enum
+   * @param timeout: set try times of HC05_BLOCK, Fail once they run out
+   * @return task_t: Success / Fail (not attached or no room by the policy, nothing queued)
+   */
+  task_t HC05_SendWith(HC05_DS *const self, const uint8_t array[], size_t len, HC05_Policy_Enum policy, uint32_t timeout);
+
+  /**
+   * @brief make room by a policy, before bytes are pushed straight into the attached buffer
+   *
+   * @param self: object pointer
+   * @param len: bytes needed
+   * @param policy: refer to HC05_Policy_Enum
+   * @param timeout: set try times of HC05_BLOCK, Fail once they run out
+   * @return task_t: Success / Fail (not attached or no room by the policy)
+   */
+  task_t HC05_Reserve(HC05_DS *const self, size_t len, HC05_Policy_Enum policy, uint32_t timeout);
+
+  /**
+   * @brief end a message pushed straight into the attached buffer (e.g. by Telemetry_End) & start the DMA
+   *
+   * @param self: object pointer
+   * @return task_t: Success / Fail (not attached)
+   */
+  task_t HC05_Transmit(HC05_DS *const self);
+
+  /**
+   * @brief check if all queued bytes are handed to the USART
+   *
+   * @param self: object pointer
+   * @return bool_t: True / False
+   */
+  bool_t HC05_isTxIdle(HC05_DS *const self);
+
+  /**
+   * @brief rate of the USART, as set up by the user or by HC05_SetBaud
+   *
+   * @param self: object pointer
+   * @return uint32_t: bit/s, 0 -> not set up
+   */
+  uint32_t HC05_GetBaud(HC05_DS *const self);
+
+  /**
+   * @brief messages removed from the TX buffer by HC05_DROP_OLDEST since the constructor
+   *
+   * @param self: object pointer
+   * @return uint32_t: amount of messages, wraps around
+   */
+  uint32_t HC05_GetDropped(HC05_DS *const self);
+
+  /**
+   * @brief TX DMA channel interrupt handler, chain the next region
+   *
+   * @param self: object pointer
+   */
+  void HC05_TxIRQHandler(HC05_DS *const self);
+
+  /**
+   * @brief receive continuously through the RX DMA channel in circular mode (USART1 ch5, USART2 ch6, USART3 ch3)
+   * @warning RXNE interrupt must stay off, NVIC of the USART & the channel are left to the user
+   *
+   * @param self: object pointer
+   * @param size: bytes of the ring (2 ~ 65535), longer than the bytes between two receives
+   * @return task_t: Success / Fail
+   */
+  task_t HC05_AttachRx(HC05_DS *const self, size_t size);
+
+  /**
+   * @brief take the received bytes out of the ring
+   *
+   * @param self: object pointer
+   * @param array: buffer to save bytes
+   * @param capacity: length of array
+   * @return size_t: amount of bytes
+   */
+  size_t HC05_Receive(HC05_DS *const self, uint8_t array[], size_t capacity);
+
+  /**
+   * @brief take the idle line event, the sender paused after a frame
+   *
+   * @param self: object pointer
+   * @return bool_t: True / False
+   */
+  bool_t HC05_TakeFrame(HC05_DS *const self);
+
+  /**
+   * @brief take the overrun event, the oldest bytes are overwritten
+   *
+   * @param self: object pointer
+   * @return bool_t: True / False
+   */
+  bool_t HC05_TakeOverrun(HC05_DS *const self);
+
+  /**
+   * @brief USART (IDLE) & RX DMA channel (HT / TC) interrupt handler
+   *
+   * @param self: object pointer
+   */
+  void HC05_RxIRQHandler(HC05_DS *const self);
+
   /* ---------------------------------------------------------------- Interface Code End */
 
 #endif // STM32F103xx_UNREADY
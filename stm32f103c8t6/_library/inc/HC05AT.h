@@ -0,0 +1,183 @@
+/**
+ * @file HC05AT.h
+ * @author Zhang, Zhen Yu (https://github.com/TooLateToDieYoung)
+ * @brief
+ * | Non-blocking AT command client of HC05. \n
+ * | Commands are queued, sent one after another through the TX DMA, \n
+ * | and their answers are matched byte by byte as they arrive.
+ * @warning
+ * | The module answers in full AT mode only (KEY high at power-up, HC05_AT_BAUD), \n
+ * | submit only when the link is known to be in AT mode, never beside a data stream. \n
+ * | All functions are called from the main thread.
+ * @version 0.1
+ * @date 2023-01-22
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef _HC05_AT_H_
+#define _HC05_AT_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+#include "HC05.h"
+
+#ifndef STM32F103xx_UNREADY
+
+  /** Def. Begin -------------------------------------------------------------------------
+   * @brief
+   *
+   */
+
+#define HC05AT_MAX_COMMAND 32 // * bytes of a command, without the line end
+
+#define HC05AT_ERROR_NONE 0x0000     // * OK
+#define HC05AT_ERROR_FAIL 0xFFFD     // * FAIL
+#define HC05AT_ERROR_OVERFLOW 0xFFFE // * answer longer than its buffer, cut
+#define HC05AT_ERROR_TIMEOUT 0xFFFF  // * no status line in time
+
+  /* -------------------------------------------------------------------------- Def. End */
+
+  /** Data Structure Begin ---------------------------------------------------------------
+   * @brief class data sturcture
+   * @warning Plz operate the object through the interface
+   *
+   */
+
+  /**
+   * @brief how a command ended
+   *
+   */
+  typedef struct
+  {
+    task_t result;  // * Success: OK seen
+    uint16_t error; // * n of ERROR:(n), or HC05AT_ERROR_xxx
+    size_t len;     // * bytes saved in answer
+  } HC05AT_Reply_t;
+
+  /**
+   * @brief completion callback, called from HC05AT_Feed() or HC05AT_Poll()
+   *
+   * @param reply: how the command ended
+   * @param context: user pointer given with the command
+   */
+  typedef void (*HC05AT_Callback_t)(const HC05AT_Reply_t *reply, void *context);
+
+  /**
+   * @brief one queued command
+   *
+   */
+  typedef struct
+  {
+    uint8_t cmd[HC05AT_MAX_COMMAND]; // * e.g. "AT+NAME?", without the line end
+    size_t len;                      // * 1 ~ HC05AT_MAX_COMMAND
+    uint8_t *answer;                 // * payload of the +XXX: lines, NULL -> discard
+    size_t capacity;                 // * length of answer
+    uint32_t timeout;                // * ms from sending to the status line
+    HC05AT_Callback_t callback;      // * NULL -> no notification
+    void *context;                   // * passed to callback
+  } HC05AT_Command_t;
+
+  typedef struct
+  {
+
+    HC05_DS *device; // * link to the module, TX DMA attached
+
+    struct
+    {
+      HC05AT_Command_t *array;
+      size_t head, tail;
+      size_t size;
+    } queue;
+
+    HC05AT_Command_t current; // * command waiting for its status line
+
+    HC05AT_Reply_t reply; // * reply of current, built while bytes arrive
+
+    uint32_t sent; // * ms, when current was sent
+
+    uint8_t line[12]; // * head of the line in progress
+    size_t column;    // * bytes of the line in progress
+    bool_t isPayload; // * ':' of a +XXX: line seen
+
+    bool_t isWaiting; // * current is sent
+
+  } HC05AT_DS;
+
+  /* ---------------------------------------------------------------- Data Structure End */
+
+  /** Interface Begin --------------------------------------------------------------------
+   * @brief
+   * | Almost directly through the register operation. \n
+   * | For each function, they provide an alternative, \n
+   * | with the same functionality, implemented with the LL library.
+   *
+   * @warning Do not change these codes, it may cause errors
+   */
+
+  /**
+   * @brief Constructor (dynamic memory)
+   *
+   * @param device: HC05 object, HC05_AttachTx() done
+   * @param depth: max queued commands
+   * @return HC05AT_DS*: dynamic memory pointer
+   */
+  HC05AT_DS *HC05AT_Constructor(HC05_DS *const device, size_t depth);
+
+  /**
+   * @brief Destructor, queued commands are dropped without callback
+   *
+   * @param self: object pointer
+   * @return task_t: Success / Fail
+   */
+  task_t HC05AT_Destructor(HC05AT_DS *const self);
+
+  /**
+   * @brief queue a command, it is sent by the next poll if the client is free
+   * @warning answer must stay valid until the callback
+   *
+   * @param self: object pointer
+   * @param command: command descriptor, copied into the queue
+   * @return task_t: Success / Fail (queue full or illegal length)
+   */
+  task_t HC05AT_Submit(HC05AT_DS *const self, const HC05AT_Command_t *const command);
+
+  /**
+   * @brief match received bytes against the command in progress
+   *
+   * @param self: object pointer
+   * @param array: bytes from the module
+   * @param len: length of array
+   * @return size_t: bytes consumed, the rest are no answer of a queued command
+   */
+  size_t HC05AT_Feed(HC05AT_DS *const self, const uint8_t array[], size_t len);
+
+  /**
+   * @brief send the next command & end the current one on timeout
+   *
+   * @param self: object pointer
+   * @param now: ms
+   */
+  void HC05AT_Poll(HC05AT_DS *const self, uint32_t now);
+
+  /**
+   * @brief check if a command is in progress or queued
+   *
+   * @param self: object pointer
+   * @return bool_t: True / False
+   */
+  bool_t HC05AT_isBusy(HC05AT_DS *const self);
+
+  /* ---------------------------------------------------------------- Interface Code End */
+
+#endif // STM32F103xx_UNREADY
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // _HC05_AT_H_
@@ -0,0 +1,174 @@
+/**
+ * @file InterfaceDMA.h
+ * @author Zhang, Zhen Yu (https://github.com/TooLateToDieYoung)
+ * @brief
+ * | People who use this library can easily drive \n
+ * | DMA channels for their own peripherals via these interfaces.
+ * | All the functions wrapped in the "interface" \n
+ * | can be called from the main thread or interrupts.
+ *
+ * @warning channel order is 1 ~ 7, the same as the reference manual
+ * @version 0.1
+ * @date 2023-01-09
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef _INTERFACE_DMA_H_
+#define _INTERFACE_DMA_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+#include "Common.h"
+
+#ifndef STM32F103xx_UNREADY
+
+  /** Def. Begin -------------------------------------------------------------------------
+   * @brief DMA_CCRx bits, combine them for _InterfaceDMA_Config()
+   * | for more infomation, plz refer to the datasheet.
+   *
+   */
+  typedef enum
+  {
+    DMA_TCIE = _BIT(1),      // * transfer complete interrupt
+    DMA_HTIE = _BIT(2),      // * half transfer interrupt
+    DMA_TEIE = _BIT(3),      // * transfer error interrupt
+    DMA_MEM2PER = _BIT(4),   // * direction: memory -> peripheral
+    DMA_CIRC = _BIT(5),      // * circular mode
+    DMA_MINC = _BIT(7),      // * memory increment
+    DMA_PRIO_MEDIUM = _BIT(12),
+    DMA_PRIO_HIGH = _BIT(13),
+    DMA_PRIO_VERY_HIGH = _BIT(12) | _BIT(13)
+  } DMA_Config_Enum;
+
+  /**
+   * @brief DMA_ISR / DMA_IFCR flags of one channel, shift them by _InterfaceDMA_Flag()
+   *
+   */
+  typedef enum
+  {
+    DMA_GIF = _BIT(0),  // * global
+    DMA_TCIF = _BIT(1), // * transfer complete
+    DMA_HTIF = _BIT(2), // * half transfer
+    DMA_TEIF = _BIT(3)  // * transfer error
+  } DMA_Flag_Enum;
+
+  /* -------------------------------------------------------------------------- Def. End */
+
+  /** Interface Begin --------------------------------------------------------------------
+   * @brief
+   * | Almost directly through the register operation. \n
+   * | For each function, they provide an alternative, \n
+   * | with the same functionality, implemented with the LL library.
+   *
+   * @warning Do not change these codes, it may cause errors
+   */
+
+  /**
+   * @brief locate the flags of a channel in DMA_ISR / DMA_IFCR
+   *
+   * @param order: channel order (1 ~ 7)
+   * @param flag: refer to DMA_Flag_Enum
+   * @return flag32_t: shifted flag
+   */
+  static inline flag32_t _InterfaceDMA_Flag(const uint8_t order, const flag32_t flag)
+  {
+    return flag << (4 * (order - 1));
+  }
+
+  /**
+   * @brief configure a channel (8 bits data, peripheral address fixed)
+   *
+   * @param channel: defined in the stm32f103xx series header
+   * @param peripheral: peripheral data register
+   * @param memory: memory address
+   * @param len: amount of bytes (1 ~ 65535)
+   * @param config: refer to DMA_Config_Enum
+   * @return task_t: Success / Fail
+   */
+  static inline task_t _InterfaceDMA_Config(DMA_Channel_TypeDef *channel, volatile const void *peripheral, volatile const void *memory, const size_t len, const flag32_t config)
+  {
+    // check if channel is running
+    if (_MASK(channel->CCR, _BIT(0)))
+      return Fail;
+
+    if (len == 0 || len > 0xFFFF)
+      return Fail;
+
+    channel->CPAR = (uint32_t)peripheral;
+    channel->CMAR = (uint32_t)memory;
+    channel->CNDTR = len;
+    channel->CCR = config;
+
+    return Success;
+  }
+
+  /**
+   * @brief enable channel
+   *
+   * @param channel: defined in the stm32f103xx series header
+   */
+  static inline void _InterfaceDMA_Enable(DMA_Channel_TypeDef *channel)
+  {
+    channel->CCR |= _BIT(0);
+  }
+
+  /**
+   * @brief disable channel
+   *
+   * @param channel: defined in the stm32f103xx series header
+   */
+  static inline void _InterfaceDMA_Disable(DMA_Channel_TypeDef *channel)
+  {
+    channel->CCR &= ~_BIT(0);
+  }
+
+  /**
+   * @brief get the amount of data items left
+   *
+   * @param channel: defined in the stm32f103xx series header
+   * @return size_t: CNDTR
+   */
+  static inline size_t _InterfaceDMA_Remaining(DMA_Channel_TypeDef *channel)
+  {
+    return (size_t)channel->CNDTR;
+  }
+
+  /**
+   * @brief check channel flag
+   *
+   * @param DMAx: defined in the stm32f103xx series header
+   * @param order: channel order (1 ~ 7)
+   * @param flag: refer to DMA_Flag_Enum
+   * @return bool_t: True / False
+   */
+  static inline bool_t _InterfaceDMA_isFlag(DMA_TypeDef *DMAx, const uint8_t order, const flag32_t flag)
+  {
+    return _MASK(DMAx->ISR, _InterfaceDMA_Flag(order, flag)) ? True : False;
+  }
+
+  /**
+   * @brief clear channel flag
+   *
+   * @param DMAx: defined in the stm32f103xx series header
+   * @param order: channel order (1 ~ 7)
+   * @param flag: refer to DMA_Flag_Enum
+   */
+  static inline void _InterfaceDMA_Clear(DMA_TypeDef *DMAx, const uint8_t order, const flag32_t flag)
+  {
+    DMAx->IFCR = _InterfaceDMA_Flag(order, flag);
+  }
+
+  /* ---------------------------------------------------------------- Interface Code End */
+
+#endif // STM32F103xx_UNREADY
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // _INTERFACE_DMA_H_
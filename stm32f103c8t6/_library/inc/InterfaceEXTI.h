@@ -0,0 +1,121 @@
+/**
+ * @file InterfaceEXTI.h
+ * @author Zhang, Zhen Yu (https://github.com/TooLateToDieYoung)
+ * @brief
+ * | People who use this library can easily route \n
+ * | GPIO edges of their own devices to EXTI lines via these interfaces.
+ * | All the functions wrapped in the "interface" \n
+ * | can be called from the main thread or interrupts.
+ *
+ * @warning AFIO clock must be enabled, NVIC of the line is left to the user
+ * @version 0.1
+ * @date 2023-01-14
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef _INTERFACE_EXTI_H_
+#define _INTERFACE_EXTI_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+#include "Common.h"
+
+#ifndef STM32F103xx_UNREADY
+
+  /** Def. Begin -------------------------------------------------------------------------
+   * @brief trigger edges, combine them for _InterfaceEXTI_Bind()
+   *
+   */
+  typedef enum
+  {
+    EXTI_RISING = _BIT(0),  // * EXTI_RTSR
+    EXTI_FALLING = _BIT(1)  // * EXTI_FTSR
+  } EXTI_Edge_Enum;
+
+  /* -------------------------------------------------------------------------- Def. End */
+
+  /** Interface Begin --------------------------------------------------------------------
+   * @brief
+   * | Almost directly through the register operation. \n
+   * | For each function, they provide an alternative, \n
+   * | with the same functionality, implemented with the LL library.
+   *
+   * @warning Do not change these codes, it may cause errors
+   */
+
+  /**
+   * @brief route a pin to its EXTI line (line number = pin order) & unmask it
+   * @warning one port only for each line number
+   *
+   * @param pin: GPIO port & order, already configured as input
+   * @param edge: refer to EXTI_Edge_Enum
+   */
+  static inline void _InterfaceEXTI_Bind(const port_t *const pin, const flag8_t edge)
+  {
+    // AFIO_EXTICRx: 4 bits for each line, 0 -> GPIOA, 1 -> GPIOB ...
+    const uint32_t port = ((uint32_t)pin->GPIOx - (uint32_t)GPIOA) / 0x400;
+    const uint8_t shift = 4 * (pin->order % 4);
+
+    AFIO->EXTICR[pin->order / 4] = (AFIO->EXTICR[pin->order / 4] & ~(0x0FU << shift)) | (port << shift);
+
+    if (_MASK(edge, EXTI_RISING))
+      EXTI->RTSR |= _BIT(pin->order);
+    else
+      EXTI->RTSR &= ~_BIT(pin->order);
+
+    if (_MASK(edge, EXTI_FALLING))
+      EXTI->FTSR |= _BIT(pin->order);
+    else
+      EXTI->FTSR &= ~_BIT(pin->order);
+
+    // ? drop an edge latched before the binding
+    EXTI->PR = _BIT(pin->order);
+    EXTI->IMR |= _BIT(pin->order);
+  }
+
+  /**
+   * @brief mask the EXTI line
+   *
+   * @param order: line number (0 ~ 15)
+   */
+  static inline void _InterfaceEXTI_Unbind(const uint8_t order)
+  {
+    EXTI->IMR &= ~_BIT(order);
+    EXTI->PR = _BIT(order);
+  }
+
+  /**
+   * @brief check if an edge is pending
+   *
+   * @param order: line number (0 ~ 15)
+   * @return bool_t: True / False
+   */
+  static inline bool_t _InterfaceEXTI_isPending(const uint8_t order)
+  {
+    return _MASK(EXTI->PR, _BIT(order)) ? True : False;
+  }
+
+  /**
+   * @brief clear the pending edge (write 1 to clear)
+   *
+   * @param order: line number (0 ~ 15)
+   */
+  static inline void _InterfaceEXTI_Clear(const uint8_t order)
+  {
+    EXTI->PR = _BIT(order);
+  }
+
+  /* ---------------------------------------------------------------- Interface Code End */
+
+#endif // STM32F103xx_UNREADY
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // _INTERFACE_EXTI_H_
@@ -0,0 +1,156 @@
+/**
+ * @file InterfaceFLASH.h
+ * @author Zhang, Zhen Yu (https://github.com/TooLateToDieYoung)
+ * @brief
+ * | People who use this library can easily keep \n
+ * | their own data in the internal flash via these interfaces.
+ * | All the functions wrapped in the "interface" \n
+ * | should be called from the main thread only.
+ *
+ * @warning
+ * | The CPU stalls while the flash is busy (code runs from it), \n
+ * | erase a page takes about 20 ms, program a half word about 50 us.
+ * @version 0.1
+ * @date 2023-01-19
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef _INTERFACE_FLASH_H_
+#define _INTERFACE_FLASH_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+#include "Common.h"
+
+#ifndef STM32F103xx_UNREADY
+
+  /** Def. Begin -------------------------------------------------------------------------
+   * @brief
+   *
+   */
+
+#define FLASH_PAGE_SIZE_BYTES 0x400U // * 1 KB for low & medium density devices
+
+  /* -------------------------------------------------------------------------- Def. End */
+
+  /** Interface Begin --------------------------------------------------------------------
+   * @brief
+   * | Almost directly through the register operation. \n
+   * | For each function, they provide an alternative, \n
+   * | with the same functionality, implemented with the LL library.
+   *
+   * @warning Do not change these codes, it may cause errors
+   */
+
+  /**
+   * @brief unlock FLASH_CR with the key sequence
+   *
+   */
+  static inline void _InterfaceFLASH_Unlock(void)
+  {
+    // check if LOCK
+    if (!_MASK(FLASH->CR, _BIT(7)))
+      return;
+
+    FLASH->KEYR = 0x45670123U; // KEY1
+    FLASH->KEYR = 0xCDEF89ABU; // KEY2
+  }
+
+  /**
+   * @brief lock FLASH_CR until the next unlock
+   *
+   */
+  static inline void _InterfaceFLASH_Lock(void)
+  {
+    FLASH->CR |= _BIT(7); // set LOCK
+  }
+
+  /**
+   * @brief wait for the end of the operation & check the result
+   *
+   * @param timeout: try times
+   * @return task_t: Success / Fail
+   */
+  static inline task_t _InterfaceFLASH_Wait(uint32_t timeout)
+  {
+    // wait until not BSY
+    while (_MASK(FLASH->SR, _BIT(0)))
+    {
+      if (!timeout)
+        return Fail;
+      timeout--;
+    }
+
+    // check PGERR & WRPRTERR, then clear them with EOP (write 1 to clear)
+    const flag32_t status = FLASH->SR;
+    FLASH->SR = _BIT(5) | _BIT(4) | _BIT(2);
+
+    return _MASK(status, _BIT(4) | _BIT(2)) ? Fail : Success;
+  }
+
+  /**
+   * @brief erase one page (all bytes -> 0xFF)
+   * @warning flash must be unlocked
+   *
+   * @param address: any address in the page
+   * @param timeout: try times
+   * @return task_t: Success / Fail
+   */
+  static inline task_t _InterfaceFLASH_ErasePage(const uint32_t address, uint32_t timeout)
+  {
+    if (_InterfaceFLASH_Wait(timeout) != Success)
+      return Fail;
+
+    FLASH->CR |= _BIT(1); // set PER
+    FLASH->AR = address;
+    FLASH->CR |= _BIT(6); // set STRT
+
+    const task_t result = _InterfaceFLASH_Wait(timeout);
+
+    FLASH->CR &= ~_BIT(1); // clear PER
+
+    return result;
+  }
+
+  /**
+   * @brief program one half word, the target must be erased (0xFFFF)
+   * @warning flash must be unlocked
+   *
+   * @param address: half word aligned
+   * @param data: half word to program
+   * @param timeout: try times
+   * @return task_t: Success / Fail
+   */
+  static inline task_t _InterfaceFLASH_Program(const uint32_t address, const uint16_t data, uint32_t timeout)
+  {
+    if (_InterfaceFLASH_Wait(timeout) != Success)
+      return Fail;
+
+    FLASH->CR |= _BIT(0); // set PG
+    *(volatile uint16_t *)address = data;
+
+    const task_t result = _InterfaceFLASH_Wait(timeout);
+
+    FLASH->CR &= ~_BIT(0); // clear PG
+
+    // ? read back, a programmed bit can never turn into 1
+    if (*(volatile const uint16_t *)address != data)
+      return Fail;
+
+    return result;
+  }
+
+  /* ---------------------------------------------------------------- Interface Code End */
+
+#endif // STM32F103xx_UNREADY
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // _INTERFACE_FLASH_H_
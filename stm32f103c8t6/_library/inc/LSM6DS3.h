@@ -18,7 +18,8 @@ extern "C"
 {
 #endif // __cplusplus
 
-#include "InterfaceSPI.h"
+#include "SPIBus.h"
+#include "InterfaceEXTI.h"
 
 #ifndef STM32F103xx_UNREADY
 
@@ -29,10 +30,28 @@ extern "C"
    */
   typedef enum
   {
+    FIFO_CTRL1 = 0x06,
+    FIFO_CTRL2,
+    FIFO_CTRL3,
+    FIFO_CTRL4,
+    FIFO_CTRL5,
+    INT1_CTRL = 0x0D,
+    INT2_CTRL,
     WHO_AM_I = 0x0F,
-    CTRL_ACCE,
-    CTRL_GYRO,
-    STATUS_R = 0x1E,
+    CTRL_ACCE, // * CTRL1_XL
+    CTRL_GYRO, // * CTRL2_G
+    CTRL3_C,
+    CTRL4_C,
+    CTRL5_C,
+    CTRL6_C,
+    CTRL7_G,
+    CTRL8_XL,
+    CTRL9_XL,
+    CTRL10_C,
+    WAKE_UP_SRC = 0x1B,
+    TAP_SRC,
+    D6D_SRC,
+    STATUS_R,
     GYRO_X_L = 0x22,
     GYRO_X_H,
     GYRO_Y_L,
@@ -44,9 +63,187 @@ extern "C"
     ACCE_Y_L,
     ACCE_Y_H,
     ACCE_Z_L,
-    ACCE_Z_H
+    ACCE_Z_H,
+    FIFO_STATUS1 = 0x3A,
+    FIFO_STATUS2,
+    FIFO_STATUS3,
+    FIFO_STATUS4,
+    FIFO_DATA_L,
+    FIFO_DATA_H,
+    TIMESTAMP0_REG = 0x40,
+    TIMESTAMP1_REG,
+    TIMESTAMP2_REG,
+    FUNC_SRC = 0x53,
+    TAP_CFG = 0x58,
+    TAP_THS_6D,
+    INT_DUR2,
+    WAKE_UP_THS,
+    WAKE_UP_DUR,
+    FREE_FALL,
+    MD1_CFG,
+    MD2_CFG,
+    X_OFS_USR = 0x73, // * LSM6DS3TR-C only
+    Y_OFS_USR,
+    Z_OFS_USR
   } LSM6DS3_Register_Enum;
 
+#define LSM6DS3_TIMESTAMP_MASK 0x00FFFFFFU // * TIMESTAMP0_REG ~ TIMESTAMP2_REG, 24 bits
+#define LSM6DS3_TIMESTAMP_US 25U          // * us per timestamp tick, TIMER_HR set
+
+  /**
+   * @brief output data rate, shared by CTRL1_XL, CTRL2_G & FIFO_CTRL5
+   *
+   */
+  typedef enum
+  {
+    ODR_OFF = 0x00,
+    ODR_12Hz5,
+    ODR_26Hz,
+    ODR_52Hz,
+    ODR_104Hz,
+    ODR_208Hz,
+    ODR_416Hz,
+    ODR_833Hz,
+    ODR_1k66Hz,
+    ODR_3k33Hz,
+    ODR_6k66Hz
+  } LSM6DS3_ODR_Enum;
+
+  /**
+   * @brief acce full-scale (CTRL1_XL FS_XL)
+   *
+   */
+  typedef enum
+  {
+    XL_FS_2G = 0x00,
+    XL_FS_16G,
+    XL_FS_4G,
+    XL_FS_8G
+  } LSM6DS3_AcceScale_Enum;
+
+  /**
+   * @brief acce anti-aliasing bandwidth (CTRL1_XL BW_XL)
+   *
+   */
+  typedef enum
+  {
+    XL_BW_400Hz = 0x00,
+    XL_BW_200Hz,
+    XL_BW_100Hz,
+    XL_BW_50Hz,
+    XL_BW_ODR // * selected by ODR automatically
+  } LSM6DS3_AcceBandwidth_Enum;
+
+  /**
+   * @brief acce digital filter on the output (CTRL8_XL)
+   *
+   */
+  typedef enum
+  {
+    XL_FILTER_OFF = 0x00,
+    XL_FILTER_LPF2, // * cutoff: ODR / 50, 100, 9, 400
+    XL_FILTER_HPF   // * cutoff: ODR / 4 (slope), 100, 9, 400
+  } LSM6DS3_AcceFilter_Enum;
+
+  /**
+   * @brief gyro full-scale (CTRL2_G FS_G & FS_125)
+   *
+   */
+  typedef enum
+  {
+    G_FS_245DPS = 0x00,
+    G_FS_125DPS = 0x01,
+    G_FS_500DPS = 0x02,
+    G_FS_1000DPS = 0x04,
+    G_FS_2000DPS = 0x06
+  } LSM6DS3_GyroScale_Enum;
+
+  /**
+   * @brief power mode of each sensor (CTRL6_C XL_HM_MODE, CTRL7_G G_HM_MODE)
+   * | low power below 52 Hz, normal at 104 & 208 Hz, high performance above.
+   *
+   */
+  typedef enum
+  {
+    POWER_HIGH_PERFORMANCE = 0x00,
+    POWER_LOW // * low power / normal, refer to the ODR
+  } LSM6DS3_Power_Enum;
+
+  /**
+   * @brief FIFO decimation factor of each sensor (FIFO_CTRL3)
+   *
+   */
+  typedef enum
+  {
+    DEC_OFF = 0x00, // * sensor not in FIFO
+    DEC_1,
+    DEC_2,
+    DEC_3,
+    DEC_4,
+    DEC_8,
+    DEC_16,
+    DEC_32
+  } LSM6DS3_Decimation_Enum;
+
+  /**
+   * @brief FIFO mode (FIFO_CTRL5)
+   *
+   */
+  typedef enum
+  {
+    FIFO_BYPASS = 0x00,
+    FIFO_STOP_WHEN_FULL = 0x01,
+    FIFO_CONTINUOUS = 0x06
+  } LSM6DS3_FIFOMode_Enum;
+
+  /**
+   * @brief interrupt pins of the device
+   *
+   */
+  typedef enum
+  {
+    LSM6DS3_INT1 = 0x00,
+    LSM6DS3_INT2
+  } LSM6DS3_Pin_Enum;
+
+  /**
+   * @brief interrupt sources, shared by INT1_CTRL & INT2_CTRL
+   *
+   */
+  typedef enum
+  {
+    INT_DRDY_XL = _BIT(0), // * acce data ready
+    INT_DRDY_G = _BIT(1),  // * gyro data ready
+    INT_FIFO_TH = _BIT(3), // * FIFO reaches the watermark
+    INT_SIGN_MOT = _BIT(6) // * significant motion, INT1 only
+  } LSM6DS3_Interrupt_Enum;
+
+  /**
+   * @brief motion events, shared by MD1_CFG & MD2_CFG
+   *
+   */
+  typedef enum
+  {
+    EVENT_SIGN_MOTION = _BIT(0), // * FUNC_SRC only, route it with INT_SIGN_MOT
+    EVENT_6D = _BIT(2),          // * orientation change
+    EVENT_DOUBLE_TAP = _BIT(3),
+    EVENT_FREE_FALL = _BIT(4),
+    EVENT_WAKE_UP = _BIT(5),
+    EVENT_SINGLE_TAP = _BIT(6),
+    EVENT_INACTIVITY = _BIT(7) // * sleep state
+  } LSM6DS3_Event_Enum;
+
+  /**
+   * @brief axes of the tap detection (TAP_CFG)
+   *
+   */
+  typedef enum
+  {
+    AXIS_Z = _BIT(0),
+    AXIS_Y = _BIT(1),
+    AXIS_X = _BIT(2)
+  } LSM6DS3_Axis_Enum;
+
   /* -------------------------------------------------------------------------- Def. End */
 
   /** Data Structure Begin ---------------------------------------------------------------
@@ -62,8 +259,145 @@ extern "C"
 
     port_t CS; // * SPI CS wire for selecting the slave device             
 
+    SPIBus_DS *bus; // * shared bus, NULL -> SPIx is owned by this device
+
+    SPIBus_Device_t device; // * CS, mode & prescaler on the shared bus
+
+    struct
+    {
+      uint8_t pattern; // * words per FIFO pattern: 0 (off), 3 or 6
+      bool_t hasGyro;  // * gyro words lead the pattern when it is stored
+      size_t skip;     // * words of a broken pattern ahead of the DMA drain
+      size_t total;    // * whole patterns in the DMA drain
+    } fifo;
+
+    struct
+    {
+      port_t line;                  // * MCU pin wired to INTx, its order is the EXTI line
+      bool_t isBound;               // * line routed to EXTI
+      volatile bool_t isPending;    // * edge not taken yet
+      volatile uint32_t timestamp;  // * time of the last edge
+    } irq[2];
+
+    uint8_t id; // * WHO_AM_I: 0x69 (LSM6DS3) or 0x6A (LSM6DS3TR-C)
+
+    uint8_t ctrl[10]; // * shadow of CTRL1_XL ~ CTRL10_C
+
+    struct
+    {
+      sint16_t gyro[3]; // * raw counts, subtracted from each sample
+      sint16_t acce[3]; // * raw counts left over by the user offset registers
+    } bias;
+
   } LSM6DS3_DS;
 
+  /**
+   * @brief FIFO configuration
+   * @warning gyro & acce must share the same decimation (or be DEC_OFF)
+   *
+   */
+  typedef struct
+  {
+    LSM6DS3_ODR_Enum odr;           // * FIFO output data rate
+    LSM6DS3_Decimation_Enum gyro;   // * gyro decimation
+    LSM6DS3_Decimation_Enum acce;   // * acce decimation
+    uint16_t watermark;             // * threshold in 16 bits words (0 ~ 4095)
+    LSM6DS3_FIFOMode_Enum mode;     // * FIFO mode
+  } LSM6DS3_FIFOConfig_t;
+
+  /**
+   * @brief acce configuration
+   *
+   */
+  typedef struct
+  {
+    LSM6DS3_ODR_Enum odr;                 // * ODR_OFF ~ ODR_6k66Hz
+    LSM6DS3_AcceScale_Enum scale;         // * full-scale
+    LSM6DS3_AcceBandwidth_Enum bandwidth; // * anti-aliasing filter
+    LSM6DS3_AcceFilter_Enum filter;       // * LPF2 / HPF
+    uint8_t cutoff;                       // * HPCF_XL (0 ~ 3)
+    LSM6DS3_Power_Enum power;             // * power mode
+  } LSM6DS3_AcceConfig_t;
+
+  /**
+   * @brief gyro configuration
+   *
+   */
+  typedef struct
+  {
+    LSM6DS3_ODR_Enum odr;         // * ODR_OFF ~ ODR_1k66Hz
+    LSM6DS3_GyroScale_Enum scale; // * full-scale
+    bool_t isHPF;                 // * high-pass filter
+    uint8_t cutoff;               // * HPCF_G (0 ~ 3): 0.0081, 0.0324, 2.07, 16.32 Hz
+    LSM6DS3_Power_Enum power;     // * power mode
+  } LSM6DS3_GyroConfig_t;
+
+  /**
+   * @brief 6-axis configuration
+   *
+   */
+  typedef struct
+  {
+    LSM6DS3_AcceConfig_t acce;
+    LSM6DS3_GyroConfig_t gyro;
+  } LSM6DS3_Config_t;
+
+  /**
+   * @brief embedded motion functions, thresholds follow the acce full-scale (FS)
+   * | durations are in ODR periods of the acce.
+   *
+   */
+  typedef struct
+  {
+    struct
+    {
+      uint8_t threshold; // * WK_THS (0 ~ 63), FS / 64 each
+      uint8_t duration;  // * WAKE_DUR (0 ~ 3), 1 ODR each
+    } wakeUp;
+
+    struct
+    {
+      flag8_t axes;      // * refer to LSM6DS3_Axis_Enum, 0 -> off
+      uint8_t threshold; // * TAP_THS (0 ~ 31), FS / 32 each
+      uint8_t shock;     // * SHOCK (0 ~ 3), 8 ODR each (0 -> 4 ODR), max over-threshold time
+      uint8_t quiet;     // * QUIET (0 ~ 3), 4 ODR each (0 -> 2 ODR), dead time after a tap
+      uint8_t gap;       // * DUR (0 ~ 15), 32 ODR each (0 -> 16 ODR), max time between double taps
+      bool_t isDouble;   // * detect double tap as well
+    } tap;
+
+    struct
+    {
+      uint8_t threshold; // * FF_THS (0 ~ 7): 156, 219, 250, 312, 344, 406, 469, 500 mg
+      uint8_t duration;  // * FF_DUR (0 ~ 63), 1 ODR each
+    } freeFall;
+
+    bool_t isSignificantMotion; // * needs acce ODR 26 Hz or above
+
+    bool_t isLatched; // * LIR, sources stay until LSM6DS3_GetMotion()
+
+  } LSM6DS3_MotionConfig_t;
+
+  /**
+   * @brief zero-rate & zero-g bias, kept as it is in the storage
+   *
+   */
+  typedef struct
+  {
+    sint16_t gyro[3]; // * raw counts
+    sint16_t acce[3]; // * raw counts
+    uint16_t scale;   // * FS_G (CTRL2_G) & FS_XL (CTRL1_XL) of the calibration
+  } LSM6DS3_Bias_t;
+
+  /**
+   * @brief one decoded FIFO pattern (raw counts)
+   *
+   */
+  typedef struct
+  {
+    sint16_t gyro[3]; // * X, Y, Z
+    sint16_t acce[3]; // * X, Y, Z
+  } LSM6DS3_Sample_t;
+
   /* ---------------------------------------------------------------- Data Structure End */
 
   /** Interface Begin --------------------------------------------------------------------
@@ -94,6 +428,7 @@ extern "C"
 
   /** 
    * @brief Configure module with default values 
+   * | acce 416 Hz, +-2 g, gyro off, BDU & IF_INC.
    * 
    * @param self: object pointer
    * @return task_t: Success / Fail
@@ -101,14 +436,73 @@ extern "C"
   task_t LSM6DS3_DefaultInit(LSM6DS3_DS *const self);
 
   /**
-   * @brief select device -> CS wire low
+   * @brief check WHO_AM_I, retry while the device is booting
+   *
+   * @param self: object pointer
+   * @param retry: max reads
+   * @param timeout: try times
+   * @return task_t: Success / Fail
+   */
+  task_t LSM6DS3_CheckID(LSM6DS3_DS *const self, uint8_t retry, uint16_t timeout);
+
+  /**
+   * @brief apply a 6-axis configuration in one burst (CTRL1_XL ~ CTRL10_C)
+   * @warning other bits in CTRLx are kept from the shadow, raw LSM6DS3_setRegister() is not tracked
+   *
+   * @param self: object pointer
+   * @param config: 6-axis configuration
+   * @param timeout: try times
+   * @return task_t: Success / Fail
+   */
+  task_t LSM6DS3_Configure(LSM6DS3_DS *const self, const LSM6DS3_Config_t *const config, uint16_t timeout);
+
+  /**
+   * @brief average stationary samples of both sensors & apply the bias
+   * | gyro bias is kept in software, acce bias goes into the user offset \n
+   * | registers on LSM6DS3TR-C (1 mg weight), the rest is kept in software.
+   * @warning keep the device still, gyro & acce must be on
+   *
+   * @param self: object pointer
+   * @param gravity: expected acce in g, e.g. {0, 0, 1} for Z up
+   * @param samples: samples to average (1 ~ 65535)
+   * @param threshold: max gyro spread of each axis in raw counts, above -> moving
+   * @param bias: save bias, keep it for LSM6DS3_SetBias() on the next boot
+   * @param timeout: try times
+   * @return task_t: Success / Fail (moving or SPI fail)
+   */
+  task_t LSM6DS3_Calibrate(LSM6DS3_DS *const self, const sint8_t gravity[3], uint16_t samples, uint16_t threshold, LSM6DS3_Bias_t *const bias, uint16_t timeout);
+
+  /**
+   * @brief apply a bias from the last calibration
+   * @warning apply it again after a full-scale change
+   *
+   * @param self: object pointer
+   * @param bias: bias of the same full-scale
+   * @param timeout: try times
+   * @return task_t: Success / Fail (full-scale mismatch or SPI fail)
+   */
+  task_t LSM6DS3_SetBias(LSM6DS3_DS *const self, const LSM6DS3_Bias_t *const bias, uint16_t timeout);
+
+  /**
+   * @brief share SPIx with other devices through the bus
+   *
+   * @param self: object pointer
+   * @param bus: bus which owns the same SPIx
+   * @return task_t: Success / Fail
+   */
+  task_t LSM6DS3_AttachBus(LSM6DS3_DS *const self, SPIBus_DS *const bus);
+
+  /**
+   * @brief select device -> (lock bus) -> CS wire low
    *
    * @param self
+   * @param timeout: try times to wait for the bus if attached
+   * @return task_t: Success / Fail (bus still busy, CS untouched)
    */
-  void LSM6DS3_HoldDevice(LSM6DS3_DS *const self);
+  task_t LSM6DS3_HoldDevice(LSM6DS3_DS *const self, uint16_t timeout);
 
   /**
-   * @brief release device -> CS wire high
+   * @brief release device -> CS wire high -> (unlock bus)
    *
    * @param self
    */
@@ -125,6 +519,18 @@ extern "C"
    */
   task_t LSM6DS3_setRegister(LSM6DS3_DS *const self, uint8_t reg, const uint8_t byte, uint16_t timeout);
 
+  /**
+   * @brief write continuous registers in one CS window (IF_INC auto-increment)
+   *
+   * @param self: object pointer
+   * @param reg: first register, refer to LSM6DS3_Register_Enum or datasheet
+   * @param array: bytes to write
+   * @param len: length of array
+   * @param timeout: try times
+   * @return task_t: Success / Fail
+   */
+  task_t LSM6DS3_setRegisters(LSM6DS3_DS *const self, uint8_t reg, const uint8_t array[], size_t len, uint16_t timeout);
+
   /**
    * @brief read one byte from the register
    *
@@ -136,6 +542,231 @@ extern "C"
    */
   task_t LSM6DS3_getRegister(LSM6DS3_DS *const self, uint8_t reg, volatile uint8_t *const byte, uint16_t timeout);
 
+  /**
+   * @brief read continuous registers in one CS window (IF_INC auto-increment)
+   *
+   * @param self: object pointer
+   * @param reg: first register, refer to LSM6DS3_Register_Enum or datasheet
+   * @param array: save bytes, read from registers
+   * @param len: length of array
+   * @param timeout: try times
+   * @return task_t: Success / Fail
+   */
+  task_t LSM6DS3_getRegisters(LSM6DS3_DS *const self, uint8_t reg, volatile uint8_t array[], size_t len, uint16_t timeout);
+
+  /**
+   * @brief read gyro & acce of the same sample (GYRO_X_L ~ ACCE_Z_H)
+   *
+   * @param self: object pointer
+   * @param sample: save raw counts
+   * @param timeout: try times
+   * @return task_t: Success / Fail
+   */
+  task_t LSM6DS3_GetSample(LSM6DS3_DS *const self, LSM6DS3_Sample_t *const sample, uint16_t timeout);
+
+  /**
+   * @brief read acce X, Y, Z (ACCE_X_L ~ ACCE_Z_H)
+   *
+   * @param self: object pointer
+   * @param acce: save raw counts
+   * @param timeout: try times
+   * @return task_t: Success / Fail
+   */
+  task_t LSM6DS3_GetAcce(LSM6DS3_DS *const self, sint16_t acce[3], uint16_t timeout);
+
+  /**
+   * @brief read gyro X, Y, Z (GYRO_X_L ~ GYRO_Z_H)
+   *
+   * @param self: object pointer
+   * @param gyro: save raw counts
+   * @param timeout: try times
+   * @return task_t: Success / Fail
+   */
+  task_t LSM6DS3_GetGyro(LSM6DS3_DS *const self, sint16_t gyro[3], uint16_t timeout);
+
+  /**
+   * @brief configure FIFO (reset it through bypass mode first)
+   *
+   * @param self: object pointer
+   * @param config: FIFO configuration
+   * @param timeout: try times
+   * @return task_t: Success / Fail
+   */
+  task_t LSM6DS3_SetFIFO(LSM6DS3_DS *const self, const LSM6DS3_FIFOConfig_t *const config, uint16_t timeout);
+
+  /**
+   * @brief read FIFO level & flags
+   *
+   * @param self: object pointer
+   * @param level: save unread words in FIFO
+   * @param flags: save FIFO_STATUS2 [7:4] (WaterM, OVER_RUN, FIFO_FULL, FIFO_EMPTY)
+   * @param timeout: try times
+   * @return task_t: Success / Fail
+   */
+  task_t LSM6DS3_GetFIFOStatus(LSM6DS3_DS *const self, volatile uint16_t *const level, volatile flag8_t *const flags, uint16_t timeout);
+
+  /**
+   * @brief check if FIFO reaches the watermark
+   *
+   * @param self: object pointer
+   * @return bool_t: True / False
+   */
+  bool_t LSM6DS3_isFIFOWatermark(LSM6DS3_DS *const self);
+
+  /**
+   * @brief drain whole patterns from FIFO in one burst & decode them
+   *
+   * @param self: object pointer
+   * @param samples: buffer to save decoded patterns
+   * @param capacity: length of samples
+   * @param count: save amount of decoded patterns
+   * @param timeout: try times
+   * @return task_t: Success / Fail
+   */
+  task_t LSM6DS3_DrainFIFO(LSM6DS3_DS *const self, LSM6DS3_Sample_t samples[], size_t capacity, volatile size_t *const count, uint16_t timeout);
+
+  /**
+   * @brief drain whole patterns from FIFO into raw bytes through the bus DMA
+   * @warning decode raw with LSM6DS3_DecodeFIFO() after the callback
+   *
+   * @param self: object pointer, attached to a bus
+   * @param raw: buffer to receive raw FIFO words
+   * @param size: length of raw
+   * @param callback: called from the DMA interrupt when done
+   * @param context: passed to callback
+   * @return task_t: Success / Fail (nothing to drain or queue full)
+   */
+  task_t LSM6DS3_DrainFIFOAsync(LSM6DS3_DS *const self, volatile uint8_t raw[], size_t size, SPIDMA_Callback_t callback, void *context);
+
+  /**
+   * @brief decode raw bytes of the last LSM6DS3_DrainFIFOAsync()
+   *
+   * @param self: object pointer
+   * @param raw: raw FIFO words
+   * @param samples: buffer to save decoded patterns
+   * @param capacity: length of samples
+   * @param count: save amount of decoded patterns
+   * @return task_t: Success / Fail
+   */
+  task_t LSM6DS3_DecodeFIFO(LSM6DS3_DS *const self, volatile const uint8_t raw[], LSM6DS3_Sample_t samples[], size_t capacity, volatile size_t *const count);
+
+  /**
+   * @brief route interrupt sources to INT1 / INT2 (INT1_CTRL / INT2_CTRL)
+   *
+   * @param self: object pointer
+   * @param pin: refer to LSM6DS3_Pin_Enum
+   * @param sources: refer to LSM6DS3_Interrupt_Enum, 0 -> pin unused
+   * @param timeout: try times
+   * @return task_t: Success / Fail
+   */
+  task_t LSM6DS3_SetInterrupt(LSM6DS3_DS *const self, LSM6DS3_Pin_Enum pin, flag8_t sources, uint16_t timeout);
+
+  /**
+   * @brief electrical mode of INT1 & INT2 (PP_OD & H_LACTIVE of CTRL3_C)
+   * @warning an INTx pin strapped to a rail must never be driven against it, use open drain
+   *
+   * @param self: object pointer
+   * @param isOpenDrain: True -> open drain, needs a pull-up on the line / False -> push-pull (default)
+   * @param isActiveLow: True -> active low / False -> active high (default)
+   * @param timeout: try times
+   * @return task_t: Success / Fail
+   */
+  task_t LSM6DS3_SetPinMode(LSM6DS3_DS *const self, bool_t isOpenDrain, bool_t isActiveLow, uint16_t timeout);
+
+  /**
+   * @brief bind an interrupt pin to the EXTI line of the MCU pin wired to it (active edge)
+   * @warning AFIO clock & NVIC of the line are left to the user
+   *
+   * @param self: object pointer
+   * @param pin: refer to LSM6DS3_Pin_Enum
+   * @param line: MCU pin, already configured as input
+   * @return task_t: Success / Fail
+   */
+  task_t LSM6DS3_BindInterrupt(LSM6DS3_DS *const self, LSM6DS3_Pin_Enum pin, const port_t *const line);
+
+  /**
+   * @brief EXTI interrupt handler, stamp pending edges of bound lines
+   *
+   * @param self: object pointer
+   * @param timestamp: current time, in the unit of the caller
+   */
+  void LSM6DS3_IRQHandler(LSM6DS3_DS *const self, uint32_t timestamp);
+
+  /**
+   * @brief take the interrupt of a pin, no SPI access
+   * @warning the line is also checked by level, latched sources never lose an edge
+   *
+   * @param self: object pointer
+   * @param pin: refer to LSM6DS3_Pin_Enum
+   * @param timestamp: save time of the last edge, NULL -> ignore
+   * @return bool_t: True (data exists) / False
+   */
+  bool_t LSM6DS3_TakeInterrupt(LSM6DS3_DS *const self, LSM6DS3_Pin_Enum pin, volatile uint32_t *const timestamp);
+
+  /**
+   * @brief read gyro & acce only if the data ready interrupt of the pin is up
+   *
+   * @param self: object pointer
+   * @param pin: pin routed with INT_DRDY_XL and / or INT_DRDY_G
+   * @param sample: save raw counts
+   * @param timestamp: save time of the edge, NULL -> ignore
+   * @param timeout: try times
+   * @return task_t: Success / Fail (no data or SPI fail)
+   */
+  task_t LSM6DS3_GetReadySample(LSM6DS3_DS *const self, LSM6DS3_Pin_Enum pin, LSM6DS3_Sample_t *const sample, volatile uint32_t *const timestamp, uint16_t timeout);
+
+  /**
+   * @brief configure wake-up, tap, free-fall & significant motion
+   * @warning route the events with LSM6DS3_RouteMotion() / LSM6DS3_SetInterrupt()
+   *
+   * @param self: object pointer
+   * @param config: thresholds & durations
+   * @param timeout: try times
+   * @return task_t: Success / Fail
+   */
+  task_t LSM6DS3_SetMotion(LSM6DS3_DS *const self, const LSM6DS3_MotionConfig_t *const config, uint16_t timeout);
+
+  /**
+   * @brief route motion events to INT1 / INT2 (MD1_CFG / MD2_CFG)
+   *
+   * @param self: object pointer
+   * @param pin: refer to LSM6DS3_Pin_Enum
+   * @param events: refer to LSM6DS3_Event_Enum (EVENT_SIGN_MOTION is ignored), 0 -> none
+   * @param timeout: try times
+   * @return task_t: Success / Fail
+   */
+  task_t LSM6DS3_RouteMotion(LSM6DS3_DS *const self, LSM6DS3_Pin_Enum pin, flag8_t events, uint16_t timeout);
+
+  /**
+   * @brief read motion sources (WAKE_UP_SRC, TAP_SRC & FUNC_SRC), latched ones are released
+   *
+   * @param self: object pointer
+   * @param events: save events, refer to LSM6DS3_Event_Enum
+   * @param timeout: try times
+   * @return task_t: Success / Fail
+   */
+  task_t LSM6DS3_GetMotion(LSM6DS3_DS *const self, volatile flag8_t *const events, uint16_t timeout);
+
+  /**
+   * @brief start the timestamp counter from 0, 25 us per tick
+   * @warning it runs on the clock of the device, map it onto the MCU time (e.g. Timebase_Clock_t)
+   *
+   * @param self: object pointer
+   * @param timeout: try times
+   * @return task_t: Success / Fail
+   */
+  task_t LSM6DS3_EnableTimestamp(LSM6DS3_DS *const self, uint16_t timeout);
+
+  /**
+   * @brief read the timestamp counter (TIMESTAMP0_REG ~ TIMESTAMP2_REG)
+   *
+   * @param self: object pointer
+   * @param ticks: save ticks, wraps at LSM6DS3_TIMESTAMP_MASK
+   * @param timeout: try times
+   * @return task_t: Success / Fail
+   */
+  task_t LSM6DS3_GetTimestamp(LSM6DS3_DS *const self, volatile uint32_t *const ticks, uint16_t timeout);
+
   /* ---------------------------------------------------------------- Interface Code End */
 
 #endif // STM32F103xx_UNREADY
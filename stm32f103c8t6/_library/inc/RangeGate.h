@@ -0,0 +1,150 @@
+/**
+ * @file RangeGate.h
+ * @author Zhang, Zhen Yu (https://github.com/TooLateToDieYoung)
+ * @brief
+ * | Motion gated ranging policy. \n
+ * | Ranging is suspended when the device lies still & the distance is stable, \n
+ * | it resumes at once on motion: a hardware event (wake-up / tap) \n
+ * | or the gyro variance of a block of samples.
+ * @warning
+ * | The gate only decides, start & stop of the range sensor are left to the user.
+ * @version 0.1
+ * @date 2023-01-20
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef _RANGE_GATE_H_
+#define _RANGE_GATE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+#include "Common.h"
+
+#ifndef STM32F103xx_UNREADY
+
+  /** Data Structure Begin ---------------------------------------------------------------
+   * @brief class data sturcture
+   * @warning Plz operate the object through the interface
+   *
+   */
+
+  /**
+   * @brief thresholds of the policy
+   *
+   */
+  typedef struct
+  {
+    uint32_t stillTime; // * no motion for so long before suspending, in the unit of now
+    uint16_t band;      // * max spread of the distances in the window, same unit as the distance
+    size_t window;      // * latest distances checked for stability
+    uint32_t variance;  // * gyro variance in raw counts ^ 2, above -> motion
+  } RangeGate_Config_t;
+
+  typedef struct
+  {
+
+    struct
+    {
+      uint16_t *array;
+      size_t index, count, size;
+    } history;
+
+    uint32_t stillTime;
+
+    uint16_t band;
+
+    uint32_t variance;
+
+    uint32_t lastMotion; // * time of the last motion
+
+    volatile bool_t isActive; // * ranging allowed, read from interrupts
+
+  } RangeGate_DS;
+
+  /* ---------------------------------------------------------------- Data Structure End */
+
+  /** Interface Begin --------------------------------------------------------------------
+   * @brief
+   * | Almost directly through the register operation. \n
+   * | For each function, they provide an alternative, \n
+   * | with the same functionality, implemented with the LL library.
+   *
+   * @warning Do not change these codes, it may cause errors
+   */
+
+  /**
+   * @brief Constructor (dynamic memory), ranging is active at first
+   *
+   * @param config: thresholds of the policy
+   * @param now: current time
+   * @return RangeGate_DS*: dynamic memory pointer
+   */
+  RangeGate_DS *RangeGate_Constructor(const RangeGate_Config_t *const config, uint32_t now);
+
+  /**
+   * @brief Destructor
+   *
+   * @param self: object pointer
+   * @return task_t: Success / Fail
+   */
+  task_t RangeGate_Destructor(RangeGate_DS *const self);
+
+  /**
+   * @brief report a hardware motion event, resume at once
+   *
+   * @param self: object pointer
+   * @param now: current time
+   */
+  void RangeGate_Motion(RangeGate_DS *const self, uint32_t now);
+
+  /**
+   * @brief software motion check with the gyro variance of one block
+   *
+   * @param self: object pointer
+   * @param now: current time
+   * @param gyro: X of the first frame, Y & Z follow it
+   * @param stride: words between frames, e.g. 6 for LSM6DS3_Sample_t
+   * @param len: frames (2 ~ 65535)
+   * @return bool_t: True (motion, resumed) / False
+   */
+  bool_t RangeGate_Inertial(RangeGate_DS *const self, uint32_t now, const sint16_t gyro[], size_t stride, size_t len);
+
+  /**
+   * @brief keep a distance for the stability check
+   *
+   * @param self: object pointer
+   * @param distance: latest distance
+   */
+  void RangeGate_Distance(RangeGate_DS *const self, uint16_t distance);
+
+  /**
+   * @brief evaluate the policy, suspend if still for stillTime & the distances are stable
+   *
+   * @param self: object pointer
+   * @param now: current time
+   * @return bool_t: True (ranging) / False (suspended)
+   */
+  bool_t RangeGate_Update(RangeGate_DS *const self, uint32_t now);
+
+  /**
+   * @brief check the decision without evaluating, safe in interrupts
+   *
+   * @param self: object pointer
+   * @return bool_t: True (ranging) / False (suspended)
+   */
+  bool_t RangeGate_isActive(RangeGate_DS *const self);
+
+  /* ---------------------------------------------------------------- Interface Code End */
+
+#endif // STM32F103xx_UNREADY
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // _RANGE_GATE_H_
@@ -0,0 +1,187 @@
+/**
+ * @file SPIBus.h
+ * @author Zhang, Zhen Yu (https://github.com/TooLateToDieYoung)
+ * @brief
+ * | Share one SPI master between several devices. \n
+ * | DMA transactions are queued from the main thread or interrupts, \n
+ * | polled users lock the bus between transactions.
+ * @warning
+ * @version 0.1
+ * @date 2023-01-12
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef _SPI_BUS_H_
+#define _SPI_BUS_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+#include "SPIDMA.h"
+
+#ifndef STM32F103xx_UNREADY
+
+  /** Def. Begin -------------------------------------------------------------------------
+   * @brief SPI_CR1 clock polarity & phase
+   *
+   */
+  typedef enum
+  {
+    SPI_MODE0 = 0x00,
+    SPI_MODE1 = _BIT(0),          // * CPHA
+    SPI_MODE2 = _BIT(1),          // * CPOL
+    SPI_MODE3 = _BIT(1) | _BIT(0) // * CPOL & CPHA
+  } SPIBus_Mode_Enum;
+
+#define SPIBUS_MAX_CLOCK 18000000U // * SCK limit of the stm32f103xx SPI master
+
+  /* -------------------------------------------------------------------------- Def. End */
+
+  /** Data Structure Begin ---------------------------------------------------------------
+   * @brief class data sturcture
+   * @warning Plz operate the object through the interface
+   *
+   */
+
+  /**
+   * @brief how to talk to one device on the bus
+   *
+   */
+  typedef struct
+  {
+    port_t CS;             // * SPI CS wire for selecting the slave device
+    SPIBus_Mode_Enum mode; // * clock polarity & phase
+    uint32_t maxClock;     // * max SCK in Hz the device accepts
+  } SPIBus_Device_t;
+
+  /**
+   * @brief one queued transaction, refer to SPIDMA_Transfer_t
+   *
+   */
+  typedef struct
+  {
+    const SPIBus_Device_t *device; // * must stay valid until the callback
+    uint8_t header[4];
+    uint8_t headerLen;
+    const uint8_t *tx;
+    volatile uint8_t *rx;
+    size_t len;
+    SPIDMA_Callback_t callback;
+    void *context;
+  } SPIBus_Transaction_t;
+
+  typedef struct
+  {
+
+    SPI_TypeDef *SPIx; // * SPIx peripheral
+
+    SPIDMA_DS *dma; // * DMA engine of SPIx
+
+    struct
+    {
+      SPIBus_Transaction_t *array;
+      volatile size_t head, tail;
+      size_t size;
+    } queue;
+
+    SPIBus_Transaction_t current; // * transaction on DMA
+
+    flag16_t config; // * CPOL, CPHA & BR currently in SPI_CR1
+
+    volatile bool_t isLocked; // * held by a polled user
+
+  } SPIBus_DS;
+
+  /* ---------------------------------------------------------------- Data Structure End */
+
+  /** Interface Begin --------------------------------------------------------------------
+   * @brief
+   * | Almost directly through the register operation. \n
+   * | For each function, they provide an alternative, \n
+   * | with the same functionality, implemented with the LL library.
+   *
+   * @warning Do not change these codes, it may cause errors
+   */
+
+  /**
+   * @brief Constructor (dynamic memory)
+   *
+   * @param SPIx: SPI1 or SPI2, already initialized as master
+   * @param depth: max queued transactions
+   * @return SPIBus_DS*: dynamic memory pointer
+   */
+  SPIBus_DS *SPIBus_Constructor(SPI_TypeDef *SPIx, size_t depth);
+
+  /**
+   * @brief Destructor
+   *
+   * @param self: object pointer
+   * @return task_t: Success / Fail
+   */
+  task_t SPIBus_Destructor(SPIBus_DS *const self);
+
+  /**
+   * @brief queue a DMA transaction, it starts at once if the bus is free
+   * @warning can be called from the main thread or interrupts
+   *
+   * @param self: object pointer
+   * @param transaction: copied into the queue
+   * @return task_t: Success / Fail (queue full)
+   */
+  task_t SPIBus_Submit(SPIBus_DS *const self, const SPIBus_Transaction_t *const transaction);
+
+  /**
+   * @brief wait for the bus, lock it & apply the device settings
+   * @warning only can be called from the main thread
+   *
+   * @param self: object pointer
+   * @param device: device to talk to
+   * @param timeout: try times
+   * @return task_t: Success / Fail
+   */
+  task_t SPIBus_Acquire(SPIBus_DS *const self, const SPIBus_Device_t *const device, uint32_t timeout);
+
+  /**
+   * @brief unlock the bus & start queued transactions
+   *
+   * @param self: object pointer
+   */
+  void SPIBus_Release(SPIBus_DS *const self);
+
+  /**
+   * @brief fastest legal SPI_CR1 BR[2:0] for a device on the live clock tree
+   *
+   * @param self: object pointer
+   * @param maxClock: max SCK in Hz
+   * @return uint8_t: BR[2:0], fPCLK / 2^(BR + 1)
+   */
+  uint8_t SPIBus_Prescaler(SPIBus_DS *const self, uint32_t maxClock);
+
+  /**
+   * @brief check if nothing is running, queued or locked
+   *
+   * @param self: object pointer
+   * @return bool_t: True / False
+   */
+  bool_t SPIBus_isIdle(SPIBus_DS *const self);
+
+  /**
+   * @brief DMA interrupt handler, call it from both rx & tx channel IRQs
+   *
+   * @param self: object pointer
+   */
+  void SPIBus_IRQHandler(SPIBus_DS *const self);
+
+  /* ---------------------------------------------------------------- Interface Code End */
+
+#endif // STM32F103xx_UNREADY
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // _SPI_BUS_H_
@@ -0,0 +1,141 @@
+/**
+ * @file SPIDMA.h
+ * @author Zhang, Zhen Yu (https://github.com/TooLateToDieYoung)
+ * @brief
+ * | Full-duplex SPI master transfers on DMA. \n
+ * | SPI1 works with DMA1 channel 2 (rx) & channel 3 (tx), \n
+ * | SPI2 works with DMA1 channel 4 (rx) & channel 5 (tx).
+ * @warning
+ * @version 0.1
+ * @date 2023-01-09
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef _SPI_DMA_H_
+#define _SPI_DMA_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+#include "InterfaceSPI.h"
+#include "InterfaceDMA.h"
+
+#ifndef STM32F103xx_UNREADY
+
+  /** Data Structure Begin ---------------------------------------------------------------
+   * @brief class data sturcture
+   * @warning Plz operate the object through the interface
+   *
+   */
+
+  /**
+   * @brief completion callback, called from the DMA interrupt
+   *
+   * @param result: Success / Fail (transfer error)
+   * @param context: user pointer given with the transfer
+   */
+  typedef void (*SPIDMA_Callback_t)(task_t result, void *context);
+
+  /**
+   * @brief one transfer in a single CS window
+   *
+   */
+  typedef struct
+  {
+    port_t CS;                  // * SPI CS wire for selecting the slave device
+    uint8_t header[4];          // * shifted by CPU before DMA starts (command, register, address ...)
+    uint8_t headerLen;          // * 0 ~ 4
+    const uint8_t *tx;          // * data to send, NULL -> dummy 0x00
+    volatile uint8_t *rx;       // * buffer to receive, NULL -> discard
+    size_t len;                 // * amount of bytes for DMA (1 ~ 65535)
+    SPIDMA_Callback_t callback; // * NULL -> no notification
+    void *context;              // * passed to callback
+  } SPIDMA_Transfer_t;
+
+  typedef struct
+  {
+
+    SPI_TypeDef *SPIx; // * SPIx peripheral
+
+    DMA_TypeDef *DMAx; // * DMA controller
+
+    struct
+    {
+      DMA_Channel_TypeDef *channel;
+      uint8_t order;
+    } rx, tx;
+
+    SPIDMA_Transfer_t current; // * transfer in progress
+
+    volatile bool_t isBusy;
+
+    uint8_t dummy; // * fill byte for rx-only transfers
+    uint8_t sink;  // * drop byte for tx-only transfers
+
+  } SPIDMA_DS;
+
+  /* ---------------------------------------------------------------- Data Structure End */
+
+  /** Interface Begin --------------------------------------------------------------------
+   * @brief
+   * | Almost directly through the register operation. \n
+   * | For each function, they provide an alternative, \n
+   * | with the same functionality, implemented with the LL library.
+   *
+   * @warning Do not change these codes, it may cause errors
+   */
+
+  /**
+   * @brief Constructor (dynamic memory)
+   *
+   * @param SPIx: SPI1 or SPI2
+   * @return SPIDMA_DS*: dynamic memory pointer
+   */
+  SPIDMA_DS *SPIDMA_Constructor(SPI_TypeDef *SPIx);
+
+  /**
+   * @brief Destructor
+   *
+   * @param self: object pointer
+   * @return task_t: Success / Fail
+   */
+  task_t SPIDMA_Destructor(SPIDMA_DS *const self);
+
+  /**
+   * @brief check if a transfer is in progress
+   *
+   * @param self: object pointer
+   * @return bool_t: True / False
+   */
+  bool_t SPIDMA_isBusy(SPIDMA_DS *const self);
+
+  /**
+   * @brief start a transfer: CS low -> header -> DMA, CS high on completion
+   * @warning buffers must stay valid until the callback
+   *
+   * @param self: object pointer
+   * @param transfer: transfer descriptor, copied into the object
+   * @return task_t: Success / Fail (busy or illegal length)
+   */
+  task_t SPIDMA_Start(SPIDMA_DS *const self, const SPIDMA_Transfer_t *const transfer);
+
+  /**
+   * @brief DMA interrupt handler, call it from both rx & tx channel IRQs
+   *
+   * @param self: object pointer
+   */
+  void SPIDMA_IRQHandler(SPIDMA_DS *const self);
+
+  /* ---------------------------------------------------------------- Interface Code End */
+
+#endif // STM32F103xx_UNREADY
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // _SPI_DMA_H_
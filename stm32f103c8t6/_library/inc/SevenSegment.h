@@ -61,10 +61,23 @@ extern "C"
    *
    */
 
+  /**
+   * @brief BSRR words of the segments on one port, a glyph is split into two nibbles
+   *
+   */
+  typedef struct
+  {
+    GPIO_TypeDef *GPIOx;
+    uint32_t low[16];  // * SegA to SegD, indexed by glyph & 0x0F
+    uint32_t high[16]; // * SegE to SegP, indexed by glyph >> 4
+  } SevenSegment_Port_t;
+
   typedef struct
   {
     port_t common;
-    port_t io[8];
+    SevenSegment_Port_t *port; // * one per distinct port of io, the common folded into its own port
+    size_t count;              // * length of port
+    bool_t isApart;            // * the common is on a port without segments, one more write
   } SevenSegment_DS;
 
   /* ---------------------------------------------------------------- Data Structure End */
@@ -96,7 +109,7 @@ extern "C"
   task_t SevenSegment_Destructor(SevenSegment_DS *const self);
 
   /**
-   * @brief Set the output segment type
+   * @brief Set the output segment type, one BSRR write per port
    * 
    * @param self: object pointer 
    * @param segment: display type 
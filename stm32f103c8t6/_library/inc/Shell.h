@@ -0,0 +1,187 @@
+/**
+ * @file Shell.h
+ * @author Zhang, Zhen Yu (https://github.com/TooLateToDieYoung)
+ * @brief
+ * | Line oriented command interpreter, e.g. on the RX stream of HC05. \n
+ * | Commands come from a static table of the user, \n
+ * | arguments are tokens pointing into the line, never copied.
+ * @warning
+ * | Handlers run from Shell_Feed(), in the thread of the caller.
+ * @version 0.1
+ * @date 2023-01-23
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef _SHELL_H_
+#define _SHELL_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+#include "Common.h"
+
+#ifndef STM32F103xx_UNREADY
+
+  /** Def. Begin -------------------------------------------------------------------------
+   * @brief
+   *
+   */
+
+#define SHELL_MAX_LINE 48  // * bytes of a line, without the line end
+#define SHELL_MAX_TOKENS 8 // * words of a line, command name included
+
+  /* -------------------------------------------------------------------------- Def. End */
+
+  /** Data Structure Begin ---------------------------------------------------------------
+   * @brief class data sturcture
+   * @warning Plz operate the object through the interface
+   *
+   */
+
+  /**
+   * @brief one word of the line, valid until the handler returns
+   *
+   */
+  typedef struct
+  {
+    const uint8_t *str; // * into the line, not terminated
+    size_t len;
+  } Shell_Token_t;
+
+  /**
+   * @brief command handler
+   *
+   * @param args: words after the command name
+   * @param argc: length of args, checked against the table
+   * @param context: user pointer given to the constructor
+   * @return task_t: Success / Fail (the shell answers "error")
+   */
+  typedef task_t (*Shell_Handler_t)(const Shell_Token_t args[], size_t argc, void *context);
+
+  /**
+   * @brief output of the shell & the handlers
+   *
+   * @param str: text, not terminated
+   * @param len: length of str
+   * @param context: user pointer given to the constructor
+   */
+  typedef void (*Shell_Print_t)(const uint8_t str[], size_t len, void *context);
+
+  /**
+   * @brief one entry of the command table
+   *
+   */
+  typedef struct
+  {
+    const char *name;        // * one or more words, e.g. "rate imu"
+    const char *usage;       // * arguments for help, e.g. "<hz>", "" -> none
+    uint8_t minArgs;         // * words after the name
+    uint8_t maxArgs;         // * up to SHELL_MAX_TOKENS - words of the name
+    Shell_Handler_t handler; // * never NULL
+  } Shell_Command_t;
+
+  typedef struct
+  {
+
+    const Shell_Command_t *table; // * static table of the user, first match wins
+    size_t count;                 // * entries of table
+
+    Shell_Print_t print; // * NULL -> no output
+    void *context;       // * passed to print & the handlers
+
+    uint8_t line[SHELL_MAX_LINE]; // * line in progress
+    size_t len;                   // * bytes in line
+    bool_t isOverflow;            // * line too long, dropped at its end
+
+  } Shell_DS;
+
+  /* ---------------------------------------------------------------- Data Structure End */
+
+  /** Interface Begin --------------------------------------------------------------------
+   * @brief
+   * | Almost directly through the register operation. \n
+   * | For each function, they provide an alternative, \n
+   * | with the same functionality, implemented with the LL library.
+   *
+   * @warning Do not change these codes, it may cause errors
+   */
+
+  /**
+   * @brief Constructor (dynamic memory)
+   *
+   * @param table: commands, must stay valid (e.g. static const)
+   * @param count: entries of table
+   * @param print: output, NULL -> none
+   * @param context: passed to print & the handlers
+   * @return Shell_DS*: dynamic memory pointer
+   */
+  Shell_DS *Shell_Constructor(const Shell_Command_t table[], size_t count, Shell_Print_t print, void *context);
+
+  /**
+   * @brief Destructor
+   *
+   * @param self: object pointer
+   * @return task_t: Success / Fail
+   */
+  task_t Shell_Destructor(Shell_DS *const self);
+
+  /**
+   * @brief take received bytes, each line run as it ends ('\r' or '\n')
+   *
+   * @param self: object pointer
+   * @param array: bytes, a line may be split over several calls
+   * @param len: length of array
+   * @return task_t: Success / Fail (a line failed, was unknown or too long)
+   */
+  task_t Shell_Feed(Shell_DS *const self, const uint8_t array[], size_t len);
+
+  /**
+   * @brief run one line, "help" lists the table
+   *
+   * @param self: object pointer
+   * @param line: words split by spaces or tabs, without the line end
+   * @param len: length of line
+   * @return task_t: Success / Fail (handler failed, unknown command or wrong argument count)
+   */
+  task_t Shell_Execute(Shell_DS *const self, const uint8_t line[], size_t len);
+
+  /**
+   * @brief print through the output of the shell, e.g. from a handler
+   *
+   * @param self: object pointer
+   * @param str: text, not terminated
+   * @param len: length of str
+   */
+  void Shell_Print(Shell_DS *const self, const uint8_t str[], size_t len);
+
+  /**
+   * @brief compare a token with a word
+   *
+   * @param token: from the line
+   * @param word: terminated string
+   * @return bool_t: True / False
+   */
+  bool_t Shell_isWord(const Shell_Token_t *const token, const char *word);
+
+  /**
+   * @brief decimal value of a token
+   *
+   * @param token: from the line
+   * @param value: save the value
+   * @return task_t: Success / Fail (not a number or above 0xFFFFFFFF)
+   */
+  task_t Shell_Unsigned(const Shell_Token_t *const token, uint32_t *const value);
+
+  /* ---------------------------------------------------------------- Interface Code End */
+
+#endif // STM32F103xx_UNREADY
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // _SHELL_H_
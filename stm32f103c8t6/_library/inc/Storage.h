@@ -0,0 +1,119 @@
+/**
+ * @file Storage.h
+ * @author Zhang, Zhen Yu (https://github.com/TooLateToDieYoung)
+ * @brief
+ * | Small records kept in the internal flash across power cycles. \n
+ * | Records are appended into one page & found by their key, \n
+ * | the latest one wins. When the page is full, the latest records \n
+ * | are copied into the other page, then the old page is erased.
+ * @warning
+ * | Both pages must be out of the program image (leave them out in the linker script). \n
+ * | The CPU stalls while the flash is busy, do not write in time critical loops.
+ * @version 0.1
+ * @date 2023-01-19
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef _STORAGE_H_
+#define _STORAGE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+#include "InterfaceFLASH.h"
+
+#ifndef STM32F103xx_UNREADY
+
+  /** Data Structure Begin ---------------------------------------------------------------
+   * @brief class data sturcture
+   * @warning Plz operate the object through the interface
+   *
+   */
+
+  typedef struct
+  {
+
+    uint32_t page[2]; // * first address of both pages
+
+    uint8_t active; // * page in use, 0 or 1
+
+    uint16_t sequence; // * bumped on each page swap, newer page wins after a power loss
+
+    uint32_t cursor; // * next free address in the active page
+
+  } Storage_DS;
+
+  /* ---------------------------------------------------------------- Data Structure End */
+
+  /** Interface Begin --------------------------------------------------------------------
+   * @brief
+   * | Almost directly through the register operation. \n
+   * | For each function, they provide an alternative, \n
+   * | with the same functionality, implemented with the LL library.
+   *
+   * @warning Do not change these codes, it may cause errors
+   */
+
+  /**
+   * @brief Constructor (dynamic memory)
+   * | mount the newer valid page, format the first one if none.
+   *
+   * @param first: page address, aligned to FLASH_PAGE_SIZE_BYTES
+   * @param second: page address, aligned to FLASH_PAGE_SIZE_BYTES
+   * @return Storage_DS*: dynamic memory pointer
+   */
+  Storage_DS *Storage_Constructor(uint32_t first, uint32_t second);
+
+  /**
+   * @brief Destructor, records stay in the flash
+   *
+   * @param self: object pointer
+   * @return task_t: Success / Fail
+   */
+  task_t Storage_Destructor(Storage_DS *const self);
+
+  /**
+   * @brief read the latest record of the key
+   *
+   * @param self: object pointer
+   * @param key: 0x0001 ~ 0xFFFE
+   * @param data: save bytes of the record
+   * @param len: expected length of the record
+   * @return task_t: Success / Fail (not found, removed, length mismatch or broken)
+   */
+  task_t Storage_Read(Storage_DS *const self, uint16_t key, uint8_t data[], size_t len);
+
+  /**
+   * @brief append a record, the page is swapped when it is full
+   * @warning the same content as the latest record is not written again
+   *
+   * @param self: object pointer
+   * @param key: 0x0001 ~ 0xFFFE
+   * @param data: bytes of the record
+   * @param len: 1 ~ 256
+   * @return task_t: Success / Fail
+   */
+  task_t Storage_Write(Storage_DS *const self, uint16_t key, const uint8_t data[], size_t len);
+
+  /**
+   * @brief remove the record of the key (append an empty one)
+   *
+   * @param self: object pointer
+   * @param key: 0x0001 ~ 0xFFFE
+   * @return task_t: Success / Fail
+   */
+  task_t Storage_Remove(Storage_DS *const self, uint16_t key);
+
+  /* ---------------------------------------------------------------- Interface Code End */
+
+#endif // STM32F103xx_UNREADY
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // _STORAGE_H_
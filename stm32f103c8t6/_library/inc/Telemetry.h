@@ -0,0 +1,266 @@
+/**
+ * @file Telemetry.h
+ * @author Zhang, Zhen Yu (https://github.com/TooLateToDieYoung)
+ * @brief
+ * | Compact binary frames for a byte stream (e.g. HC05). \n
+ * | frame: COBS( type | sequence | varint fields ... | CRC-16 ) 0x00 \n
+ * | The encoder writes straight into a TX buffer, \n
+ * | the decoder is shared with the host tools (_tools/Telemetry). \n
+ * | Streams of slowly changing channels send deltas between keyframes.
+ * @warning
+ * | The decoder never needs the device, it also builds with HOST_TOOLS.
+ * @version 0.1
+ * @date 2023-01-22
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef _TELEMETRY_H_
+#define _TELEMETRY_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+#include "Buffer.h"
+
+#ifndef STM32F103xx_UNREADY
+
+  /** Def. Begin -------------------------------------------------------------------------
+   * @brief
+   *
+   */
+
+#define TELEMETRY_MAX_RAW 64 // * type, sequence, fields & CRC of a frame before COBS, < 254: one COBS block
+#define TELEMETRY_MAX_FRAME (TELEMETRY_MAX_RAW + 2) // * bytes on the wire: COBS code & delimiter added
+#define TELEMETRY_HEADER 2                          // * type & sequence
+#define TELEMETRY_KEYFRAME 0x80                     // * type flag of a stream frame with whole values
+
+  /* -------------------------------------------------------------------------- Def. End */
+
+  /** Data Structure Begin ---------------------------------------------------------------
+   * @brief class data sturcture
+   * @warning Plz operate the object through the interface
+   *
+   */
+
+  typedef struct
+  {
+
+    uint8_t raw[TELEMETRY_MAX_RAW]; // * frame in progress, before CRC & COBS
+    size_t len;                     // * bytes in raw
+
+    uint8_t sequence; // * of the next frame, a gap tells the decoder about lost frames
+
+    bool_t isOverflow; // * a field did not fit, the frame is dropped
+
+  } Telemetry_DS;
+
+  typedef struct
+  {
+
+    uint8_t frame[TELEMETRY_MAX_RAW]; // * decoded bytes of the frame in progress
+    size_t len;                       // * bytes in frame
+
+    uint8_t remain; // * bytes left in the COBS block
+    uint8_t code;   // * code of the COBS block
+
+    bool_t isBroken; // * overflow, the rest of the frame is skipped
+
+    uint8_t sequence; // * expected sequence of the next frame
+    bool_t isSynced;  // * a frame was seen, sequence is meaningful
+
+    uint32_t frames;    // * good frames
+    uint32_t lost;      // * frames missing between two good ones
+    uint32_t corrupted; // * frames dropped by CRC, length or COBS
+
+  } Telemetry_Decoder_DS;
+
+  typedef struct
+  {
+
+    sint32_t *last;  // * value of each channel in the last frame
+    size_t channels; // * values per frame
+
+    uint16_t interval; // * frames from one keyframe to the next
+    uint16_t count;    // * frames since the last keyframe
+
+    uint32_t lost;   // * lost count of the decoder at the last frame (decode side)
+    bool_t isSynced; // * last holds the values of the sender (decode side)
+
+  } Telemetry_Stream_DS;
+
+  /* ---------------------------------------------------------------- Data Structure End */
+
+  /** Interface Begin --------------------------------------------------------------------
+   * @brief
+   * | Almost directly through the register operation. \n
+   * | For each function, they provide an alternative, \n
+   * | with the same functionality, implemented with the LL library.
+   *
+   * @warning Do not change these codes, it may cause errors
+   */
+
+  /**
+   * @brief Constructor (dynamic memory) of an encoder
+   *
+   * @return Telemetry_DS*: dynamic memory pointer
+   */
+  Telemetry_DS *Telemetry_Constructor(void);
+
+  /**
+   * @brief Destructor
+   *
+   * @param self: object pointer
+   * @return task_t: Success / Fail
+   */
+  task_t Telemetry_Destructor(Telemetry_DS *const self);
+
+  /**
+   * @brief start a frame, the last one not ended is dropped
+   *
+   * @param self: object pointer
+   * @param type: kind of the frame, defined by the user
+   */
+  void Telemetry_Begin(Telemetry_DS *const self, uint8_t type);
+
+  /**
+   * @brief append an unsigned field, 1 ~ 5 bytes (LEB128 varint)
+   *
+   * @param self: object pointer
+   * @param value: field
+   * @return task_t: Success / Fail (frame full)
+   */
+  task_t Telemetry_Unsigned(Telemetry_DS *const self, uint32_t value);
+
+  /**
+   * @brief append a signed field, zig-zag: small magnitudes stay short either sign
+   *
+   * @param self: object pointer
+   * @param value: field
+   * @return task_t: Success / Fail (frame full)
+   */
+  task_t Telemetry_Signed(Telemetry_DS *const self, sint32_t value);
+
+  /**
+   * @brief append CRC, stuff & delimit the frame straight into a buffer, all or nothing
+   *
+   * @param self: object pointer
+   * @param buffer: TX buffer (e.g. attached by HC05_AttachTx)
+   * @return task_t: Success / Fail (field overflow or not enough space, nothing written)
+   */
+  task_t Telemetry_End(Telemetry_DS *const self, Buffer_DS *const buffer);
+
+  /**
+   * @brief bytes Telemetry_End() will push for the frame in progress
+   *
+   * @param self: object pointer
+   * @return size_t: length of the stuffed & delimited frame
+   */
+  size_t Telemetry_Size(const Telemetry_DS *const self);
+
+  /**
+   * @brief reset a decoder
+   *
+   * @param decoder: decoder, static or dynamic memory of the user
+   */
+  void Telemetry_Decoder_Init(Telemetry_Decoder_DS *const decoder);
+
+  /**
+   * @brief take one byte of the stream
+   *
+   * @param decoder: decoder
+   * @param byte: from the stream
+   * @return task_t: Success (a good frame is in decoder->frame, without CRC) / Fail (not yet or dropped)
+   */
+  task_t Telemetry_Decode(Telemetry_Decoder_DS *const decoder, uint8_t byte);
+
+  /**
+   * @brief read an unsigned field
+   *
+   * @param frame: decoded frame
+   * @param len: length of frame
+   * @param offset: index of the field, moved past it (starts at TELEMETRY_HEADER)
+   * @param value: save the field
+   * @return task_t: Success / Fail (end of frame or broken varint)
+   */
+  task_t Telemetry_ReadUnsigned(const uint8_t frame[], size_t len, size_t *const offset, uint32_t *const value);
+
+  /**
+   * @brief read a signed field
+   *
+   * @param frame: decoded frame
+   * @param len: length of frame
+   * @param offset: index of the field, moved past it
+   * @param value: save the field
+   * @return task_t: Success / Fail (end of frame or broken varint)
+   */
+  task_t Telemetry_ReadSigned(const uint8_t frame[], size_t len, size_t *const offset, sint32_t *const value);
+
+  /**
+   * @brief Constructor (dynamic memory) of a delta stream, one on each side of the link
+   *
+   * @param channels: values per frame (1 ~ 16)
+   * @param interval: frames from one keyframe to the next (1: keyframes only)
+   * @return Telemetry_Stream_DS*: dynamic memory pointer
+   */
+  Telemetry_Stream_DS *Telemetry_Stream_Constructor(size_t channels, uint16_t interval);
+
+  /**
+   * @brief Destructor
+   *
+   * @param self: object pointer
+   * @return task_t: Success / Fail
+   */
+  task_t Telemetry_Stream_Destructor(Telemetry_Stream_DS *const self);
+
+  /**
+   * @brief force a keyframe next, e.g. after a frame is dropped
+   *
+   * @param self: object pointer
+   */
+  void Telemetry_Stream_Reset(Telemetry_Stream_DS *const self);
+
+  /**
+   * @brief begin a frame of the stream & append its values, whole or as deltas
+   * | End the frame with Telemetry_End(), more fields may follow the values.
+   *
+   * @param self: object pointer
+   * @param telemetry: encoder
+   * @param type: kind of the frame (0x00 ~ 0x7F), TELEMETRY_KEYFRAME is added on keyframes
+   * @param values: one per channel
+   * @return task_t: Success / Fail (frame full, a keyframe is forced next)
+   */
+  task_t Telemetry_Stream_Encode(Telemetry_Stream_DS *const self, Telemetry_DS *const telemetry, uint8_t type, const sint32_t values[]);
+
+  /**
+   * @brief restore the values of a good frame of the stream
+   *
+   * @param self: object pointer
+   * @param decoder: decoder holding the frame
+   * @param offset: index of the first value, moved past the last (starts at TELEMETRY_HEADER)
+   * @param values: save one per channel
+   * @return task_t: Success / Fail (broken frame, or a delta while out of sync: wait for a keyframe)
+   */
+  task_t Telemetry_Stream_Decode(Telemetry_Stream_DS *const self, const Telemetry_Decoder_DS *const decoder, size_t *const offset, sint32_t values[]);
+
+  /**
+   * @brief CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+   *
+   * @param array: bytes
+   * @param len: length of array
+   * @return uint16_t: CRC
+   */
+  uint16_t Telemetry_CRC16(const uint8_t array[], size_t len);
+
+  /* ---------------------------------------------------------------- Interface Code End */
+
+#endif // STM32F103xx_UNREADY
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // _TELEMETRY_H_
@@ -0,0 +1,146 @@
+/**
+ * @file TiltRange.h
+ * @author Zhang, Zhen Yu (https://github.com/TooLateToDieYoung)
+ * @brief
+ * | Tilt compensation of a range sensor with the IMU attitude. \n
+ * | Attitudes are kept with their timestamps, each distance is \n
+ * | aligned with the nearest one & projected onto the gravity axis.
+ * @warning
+ * @version 0.1
+ * @date 2023-01-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef _TILT_RANGE_H_
+#define _TILT_RANGE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+#include "Fusion.h"
+
+#ifndef STM32F103xx_UNREADY
+
+  /** Data Structure Begin ---------------------------------------------------------------
+   * @brief class data sturcture
+   * @warning Plz operate the object through the interface
+   *
+   */
+
+  /**
+   * @brief mounting & thresholds
+   *
+   */
+  typedef struct
+  {
+    q15_t axis[3];    // * Q15 unit vector, range sensor boresight in the IMU frame
+    uint32_t maxRate; // * gyro raw counts, |gyro| above -> moving
+    uint32_t maxSkew; // * us, nearest attitude further -> not aligned
+  } TiltRange_Config_t;
+
+  /**
+   * @brief one attitude in the history
+   *
+   */
+  typedef struct
+  {
+    uint32_t timestamp; // * us
+    q15_t gravity[3];   // * Q15 unit vector in the IMU frame
+    uint32_t rate;      // * |gyro| ^ 2 in raw counts
+  } TiltRange_Attitude_t;
+
+  /**
+   * @brief one compensated distance
+   *
+   */
+  typedef struct
+  {
+    uint16_t vertical;   // * same unit as the distance
+    uint16_t horizontal; // * same unit as the distance
+    q15_t cosine;        // * Q15, cos of the angle between boresight & gravity
+    bool_t isMoving;     // * gyro above maxRate in the window
+    bool_t isAligned;    // * attitude found within maxSkew
+  } TiltRange_Result_t;
+
+  typedef struct
+  {
+
+    struct
+    {
+      TiltRange_Attitude_t *array;
+      size_t head, tail; // * free-running, tail - head is the length
+      size_t size;
+    } history;
+
+    q15_t axis[3];
+
+    uint32_t maxRate; // * squared
+
+    uint32_t maxSkew;
+
+  } TiltRange_DS;
+
+  /* ---------------------------------------------------------------- Data Structure End */
+
+  /** Interface Begin --------------------------------------------------------------------
+   * @brief
+   * | Almost directly through the register operation. \n
+   * | For each function, they provide an alternative, \n
+   * | with the same functionality, implemented with the LL library.
+   *
+   * @warning Do not change these codes, it may cause errors
+   */
+
+  /**
+   * @brief Constructor (dynamic memory)
+   *
+   * @param config: mounting & thresholds
+   * @param depth: attitudes kept, cover at least one ranging window
+   * @return TiltRange_DS*: dynamic memory pointer
+   */
+  TiltRange_DS *TiltRange_Constructor(const TiltRange_Config_t *const config, size_t depth);
+
+  /**
+   * @brief Destructor
+   *
+   * @param self: object pointer
+   * @return task_t: Success / Fail
+   */
+  task_t TiltRange_Destructor(TiltRange_DS *const self);
+
+  /**
+   * @brief keep an attitude, the oldest one is dropped when full
+   * @warning push in time order
+   *
+   * @param self: object pointer
+   * @param timestamp: us
+   * @param gravity: Q15 unit vector, refer to Fusion_GetGravity()
+   * @param gyro: X, Y, Z raw counts of the same frame
+   */
+  void TiltRange_Push(TiltRange_DS *const self, uint32_t timestamp, const q15_t gravity[3], const sint16_t gyro[3]);
+
+  /**
+   * @brief compensate one distance with the nearest attitude
+   *
+   * @param self: object pointer
+   * @param timestamp: us, middle of the ranging window
+   * @param window: us, half width of the ranging window for the motion check
+   * @param distance: slant distance along the boresight
+   * @param result: save compensated distance
+   * @return task_t: Success / Fail (no attitude)
+   */
+  task_t TiltRange_Measure(TiltRange_DS *const self, uint32_t timestamp, uint32_t window, uint16_t distance, TiltRange_Result_t *const result);
+
+  /* ---------------------------------------------------------------- Interface Code End */
+
+#endif // STM32F103xx_UNREADY
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // _TILT_RANGE_H_
@@ -0,0 +1,169 @@
+/**
+ * @file Timebase.h
+ * @author Zhang, Zhen Yu (https://github.com/TooLateToDieYoung)
+ * @brief
+ * | Common microsecond timebase of the MCU. \n
+ * | SysTick extends the DWT cycle counter, so the time is exact \n
+ * | to the cycle between ticks & never wraps in 71 minutes. \n
+ * | Counters of other devices (e.g. LSM6DS3 timestamp) are mapped \n
+ * | onto it by a clock, which tracks their drift & offset.
+ * @warning
+ * | Timebase_Tick() must be called at least once per 59 s (CYCCNT wraps at 72 MHz), \n
+ * | SysTick is the natural place.
+ * @version 0.1
+ * @date 2023-01-21
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef _TIMEBASE_H_
+#define _TIMEBASE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+#include "Common.h"
+
+#ifndef STM32F103xx_UNREADY
+
+  /** Data Structure Begin ---------------------------------------------------------------
+   * @brief class data sturcture
+   * @warning Plz operate the object through the interface
+   *
+   */
+
+  typedef struct
+  {
+
+    uint32_t cyclesPerMicro; // * core clock in MHz
+
+    struct
+    {
+      uint32_t cycles; // * CYCCNT at the epoch
+      uint32_t micros; // * us at the epoch
+    } epoch[2];        // * double buffered, one is written while the other is read
+
+    volatile uint32_t sequence; // * bumped by each tick, its LSB is the epoch in use
+
+  } Timebase_DS;
+
+  typedef struct
+  {
+
+    uint32_t mask; // * remote counter wraps at mask, (2 ^ n) - 1
+
+    uint32_t rate; // * Q16, local us per remote tick
+
+    uint32_t minSpan; // * remote ticks between two rate updates
+
+    struct
+    {
+      uint32_t remote; // * remote ticks
+      uint32_t local;  // * us
+    } anchor;
+
+    bool_t isLocked; // * anchor exists
+
+  } Timebase_Clock_DS;
+
+  /* ---------------------------------------------------------------- Data Structure End */
+
+  /** Interface Begin --------------------------------------------------------------------
+   * @brief
+   * | Almost directly through the register operation. \n
+   * | For each function, they provide an alternative, \n
+   * | with the same functionality, implemented with the LL library.
+   *
+   * @warning Do not change these codes, it may cause errors
+   */
+
+  /**
+   * @brief Constructor (dynamic memory), the DWT cycle counter is enabled
+   *
+   * @param coreClock: Hz, a multiple of 1 MHz (e.g. SystemCoreClock)
+   * @return Timebase_DS*: dynamic memory pointer
+   */
+  Timebase_DS *Timebase_Constructor(uint32_t coreClock);
+
+  /**
+   * @brief Destructor, the cycle counter keeps running
+   *
+   * @param self: object pointer
+   * @return task_t: Success / Fail
+   */
+  task_t Timebase_Destructor(Timebase_DS *const self);
+
+  /**
+   * @brief move the epoch forward, call it from SysTick IT
+   *
+   * @param self: object pointer
+   */
+  void Timebase_Tick(Timebase_DS *const self);
+
+  /**
+   * @brief current time, safe in any thread & interrupt
+   *
+   * @param self: object pointer
+   * @return uint32_t: us, wraps in 71 minutes
+   */
+  uint32_t Timebase_Micros(Timebase_DS *const self);
+
+  /**
+   * @brief Constructor (dynamic memory) of a remote clock
+   *
+   * @param mask: remote counter wraps at mask, (2 ^ n) - 1
+   * @param rate: Q16, nominal local us per remote tick
+   * @param minSpan: remote ticks between two rate updates, longer -> less jitter
+   * @return Timebase_Clock_DS*: dynamic memory pointer
+   */
+  Timebase_Clock_DS *Timebase_Clock_Constructor(uint32_t mask, uint32_t rate, uint32_t minSpan);
+
+  /**
+   * @brief Destructor
+   *
+   * @param self: object pointer
+   * @return task_t: Success / Fail
+   */
+  task_t Timebase_Clock_Destructor(Timebase_Clock_DS *const self);
+
+  /**
+   * @brief feed one pair of readings taken at the same moment
+   * | e.g. the remote counter read between two local times, with their middle.
+   *
+   * @param self: object pointer
+   * @param remote: remote ticks
+   * @param local: us
+   */
+  void Timebase_Clock_Observe(Timebase_Clock_DS *const self, uint32_t remote, uint32_t local);
+
+  /**
+   * @brief map remote ticks onto the local time
+   * @warning the remote ticks must be within half a wrap of the last observation
+   *
+   * @param self: object pointer
+   * @param remote: remote ticks
+   * @return uint32_t: us
+   */
+  uint32_t Timebase_Clock_Convert(Timebase_Clock_DS *const self, uint32_t remote);
+
+  /**
+   * @brief length of remote ticks in the local time
+   *
+   * @param self: object pointer
+   * @param ticks: remote ticks
+   * @return uint32_t: us
+   */
+  uint32_t Timebase_Clock_Scale(Timebase_Clock_DS *const self, uint32_t ticks);
+
+  /* ---------------------------------------------------------------- Interface Code End */
+
+#endif // STM32F103xx_UNREADY
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // _TIMEBASE_H_
@@ -19,6 +19,7 @@ extern "C"
 #endif // __cplusplus
 
 #include "InterfaceI2C.h"
+#include "InterfaceEXTI.h"
 
 #ifndef STM32F103xx_UNREADY
 
@@ -34,6 +35,15 @@ extern "C"
 
     uint8_t address;
 
+    struct
+    {
+      port_t line;                 // * MCU pin wired to GPIO1, its order is the EXTI line
+      bool_t isBound;              // * line routed to EXTI
+      uint8_t polarity;            // * active level of GPIO1
+      volatile bool_t isPending;   // * edge not taken yet
+      volatile uint32_t timestamp; // * time of the last edge
+    } irq;
+
   } VL53L1X_DS;
 
   /* ---------------------------------------------------------------- Data Structure End */
@@ -152,6 +162,44 @@ extern "C"
    */
   task_t VL53L1X_StopRanging(VL53L1X_DS *const self);
 
+  /**
+   * @brief set the timing budget of the long distance mode, the inter-measurement period follows it
+   * @warning stop the ranging first
+   *
+   * @param self: object pointer
+   * @param budget: ms, one of 20, 33, 50, 100 (default), 200, 500
+   * @return task_t: Success / Fail (unsupported budget)
+   */
+  task_t VL53L1X_SetTimingBudget(VL53L1X_DS *const self, uint16_t budget);
+
+  /**
+   * @brief bind GPIO1 to the EXTI line of the MCU pin wired to it (edge of the active level)
+   * @warning AFIO clock & NVIC of the line are left to the user
+   *
+   * @param self: object pointer
+   * @param line: MCU pin, already configured as input
+   * @return task_t: Success / Fail
+   */
+  task_t VL53L1X_BindInterrupt(VL53L1X_DS *const self, const port_t *const line);
+
+  /**
+   * @brief EXTI interrupt handler, stamp the pending edge of the bound line
+   *
+   * @param self: object pointer
+   * @param timestamp: current time, in the unit of the caller
+   */
+  void VL53L1X_IRQHandler(VL53L1X_DS *const self, uint32_t timestamp);
+
+  /**
+   * @brief take the data ready interrupt, no I2C access
+   * @warning GPIO1 stays active until VL53L1X_ClearInterrupt(), it is also checked by level
+   *
+   * @param self: object pointer
+   * @param timestamp: save time of the last edge, NULL -> ignore
+   * @return bool_t: True (data exists) / False
+   */
+  bool_t VL53L1X_TakeInterrupt(VL53L1X_DS *const self, volatile uint32_t *const timestamp);
+
   /* ---------------------------------------------------------------- Interface Code End */
 
 #endif // STM32F103xx_UNREADY
@@ -10,12 +10,47 @@
 // ! Do not expose it
 struct Buffer_DS
 {
-  size_t head, tail, size;
+  volatile size_t head, tail; // * 0 ~ (2 * size - 1), full & empty differ without a spare byte
+  size_t size;
   uint8_t *array;
 };
 
 /* ---------------------------------------------------------------- Data Structure End */
 
+/** Class Private Functions Begin ---------------------------------------------------------------
+ * @brief
+ *
+ */
+
+/**
+ * @brief position of a running index in the array
+ *
+ * @param self: object pointer
+ * @param index: head or tail
+ * @return size_t: 0 ~ (size - 1)
+ */
+static inline size_t _Buffer_Offset(Buffer_DS *const self, const size_t index)
+{
+  return (index < self->size) ? index : (index - self->size);
+}
+
+/**
+ * @brief move a running index forward
+ *
+ * @param self: object pointer
+ * @param index: head or tail
+ * @param step: 0 ~ (2 * size)
+ * @return size_t: next index
+ */
+static inline size_t _Buffer_Advance(Buffer_DS *const self, const size_t index, const size_t step)
+{
+  const size_t next = index + step;
+
+  return (next < 2 * self->size) ? next : (next - 2 * self->size);
+}
+
+/* ---------------------------------------------------------------- Class Private Functions End */
+
 /** Class Public Functions Begin ---------------------------------------------------------------
  * @brief
  *
@@ -23,6 +58,9 @@ struct Buffer_DS
 
 Buffer_DS *Buffer_Constructor(size_t size)
 {
+  if (size == 0)
+    return NULL;
+
   Buffer_DS *obj = (Buffer_DS *)calloc(1, sizeof(Buffer_DS));
 
   if (obj == NULL)
@@ -61,9 +99,10 @@ task_t Buffer_Push(Buffer_DS *const self, const uint8_t byte)
   if (Buffer_Length(self) == self->size)
     return Fail;
 
-  self->array[self->tail] = byte;
+  self->array[_Buffer_Offset(self, self->tail)] = byte;
 
-  self->tail++;
+  // ? publish the byte after it is written, the reader may be an interrupt
+  self->tail = _Buffer_Advance(self, self->tail, 1);
 
   return Success;
 }
@@ -73,19 +112,19 @@ task_t Buffer_Take(Buffer_DS *const self, volatile uint8_t *byte)
   if (Buffer_Length(self) == 0)
     return Fail;
 
-  *byte = self->array[self->head];
+  *byte = self->array[_Buffer_Offset(self, self->head)];
 
-  self->head++;
+  self->head = _Buffer_Advance(self, self->head, 1);
 
   return Success;
 }
 
 task_t Buffer_Index(Buffer_DS *const self, const size_t index, volatile uint8_t *byte)
 {
-  if (Buffer_Length(self) < index)
+  if (Buffer_Length(self) <= index)
     return Fail;
 
-  *byte = self->array[index];
+  *byte = self->array[_Buffer_Offset(self, _Buffer_Advance(self, self->head, index))];
 
   return Success;
 }
@@ -99,7 +138,50 @@ task_t Buffer_Flush(Buffer_DS *const self)
 
 size_t Buffer_Length(Buffer_DS *const self)
 {
-  return (self->tail - self->head);
+  const size_t head = self->head, tail = self->tail;
+
+  return (tail >= head) ? (tail - head) : (tail + 2 * self->size - head);
+}
+
+size_t Buffer_Space(Buffer_DS *const self)
+{
+  return self->size - Buffer_Length(self);
+}
+
+size_t Buffer_Region(Buffer_DS *const self, const uint8_t **const region)
+{
+  const size_t length = Buffer_Length(self);
+  const size_t offset = _Buffer_Offset(self, self->head);
+
+  *region = &self->array[offset];
+
+  // ? stop at the end of the array, the rest starts from the front
+  return (offset + length <= self->size) ? length : (self->size - offset);
+}
+
+task_t Buffer_Skip(Buffer_DS *const self, const size_t len)
+{
+  if (Buffer_Length(self) < len)
+    return Fail;
+
+  self->head = _Buffer_Advance(self, self->head, len);
+
+  return Success;
+}
+
+task_t Buffer_Cut(Buffer_DS *const self, const size_t index, const size_t len)
+{
+  const size_t length = Buffer_Length(self);
+
+  if (index > length || length - index < len)
+    return Fail;
+
+  for (size_t i = index; i + len < length; ++i)
+    self->array[_Buffer_Offset(self, _Buffer_Advance(self, self->head, i))] = self->array[_Buffer_Offset(self, _Buffer_Advance(self, self->head, i + len))];
+
+  self->tail = _Buffer_Advance(self, self->tail, 2 * self->size - len);
+
+  return Success;
 }
 
 bool_t Buffer_isEndAs(Buffer_DS *const self, const uint8_t compare[], size_t len)
@@ -108,7 +190,7 @@ bool_t Buffer_isEndAs(Buffer_DS *const self, const uint8_t compare[], size_t len
     return False;
 
   for (size_t i = 1; i <= len; ++i)
-    if (self->array[self->tail - i] != compare[len - i])
+    if (self->array[_Buffer_Offset(self, _Buffer_Advance(self, self->tail, 2 * self->size - i))] != compare[len - i])
       return False;
 
   return True;
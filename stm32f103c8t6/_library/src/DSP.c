@@ -0,0 +1,361 @@
+#include "DSP.h"
+#include <stdlib.h>
+
+#ifndef STM32F103xx_UNREADY
+
+/** Class Private Functions Begin ---------------------------------------------------------------
+ * @brief
+ *
+ */
+
+/**
+ * @brief saturate into Q15
+ *
+ * @param value: Q15 value in 64 bits
+ * @return q15_t: -32768 ~ 32767
+ */
+static inline q15_t _DSP_Saturate(const sint64_t value)
+{
+  if (value > 32767)
+    return 32767;
+  if (value < -32768)
+    return -32768;
+
+  return (q15_t)value;
+}
+
+/* ---------------------------------------------------------------- Class Private Functions End */
+
+/** Class Public Functions Begin ---------------------------------------------------------------
+ * @brief
+ *
+ */
+
+// ? FIR ---------------------------------------------------------------------------------------
+DSP_FIR_DS *DSP_FIR_Constructor(const q15_t coeffs[], size_t taps, size_t block)
+{
+  if (taps == 0 || block == 0)
+    return NULL;
+
+  DSP_FIR_DS *obj = (DSP_FIR_DS *)calloc(1, sizeof(DSP_FIR_DS));
+
+  if (obj == NULL)
+    return NULL;
+
+  obj->state = (q15_t *)calloc(taps - 1 + block, sizeof(q15_t));
+
+  if (obj->state == NULL)
+  {
+    free(obj);
+    return NULL;
+  }
+
+  obj->coeffs = coeffs;
+  obj->taps = taps;
+  obj->block = block;
+
+  return obj;
+}
+
+task_t DSP_FIR_Destructor(DSP_FIR_DS *const self)
+{
+  if (self == NULL)
+    return Success;
+
+  free(self->state);
+  free(self);
+
+  return Success;
+}
+
+void DSP_FIR_Reset(DSP_FIR_DS *const self)
+{
+  for (size_t i = 0; i < self->taps - 1 + self->block; ++i)
+    self->state[i] = 0;
+}
+
+task_t DSP_FIR_Process(DSP_FIR_DS *const self, const q15_t in[], size_t stride, q15_t out[], size_t len)
+{
+  if (len > self->block)
+    return Fail;
+
+  const size_t history = self->taps - 1;
+
+  // ? new block right after the history, so the MAC loop needs no modulo
+  for (size_t i = 0; i < len; ++i)
+    self->state[history + i] = in[i * stride];
+
+  for (size_t n = 0; n < len; ++n)
+  {
+    sint64_t acc = 0;
+
+    // ? indexed, a pointer walking down would step before state[0] on the last tap
+    for (size_t k = 0; k < self->taps; ++k)
+      acc += (sint32_t)self->coeffs[k] * self->state[history + n - k];
+
+    out[n] = _DSP_Saturate((acc + _BIT(14)) >> 15);
+  }
+
+  // keep the last (taps - 1) samples as the next history
+  for (size_t i = 0; i < history; ++i)
+    self->state[i] = self->state[len + i];
+
+  return Success;
+}
+
+// ? Biquad ------------------------------------------------------------------------------------
+DSP_Biquad_DS *DSP_Biquad_Constructor(const q15_t coeffs[], size_t stages, uint8_t shift)
+{
+  if (stages == 0 || shift > 2)
+    return NULL;
+
+  DSP_Biquad_DS *obj = (DSP_Biquad_DS *)calloc(1, sizeof(DSP_Biquad_DS));
+
+  if (obj == NULL)
+    return NULL;
+
+  obj->state = (q15_t *)calloc(4 * stages, sizeof(q15_t));
+
+  if (obj->state == NULL)
+  {
+    free(obj);
+    return NULL;
+  }
+
+  obj->coeffs = coeffs;
+  obj->stages = stages;
+  obj->shift = shift;
+
+  return obj;
+}
+
+task_t DSP_Biquad_Destructor(DSP_Biquad_DS *const self)
+{
+  if (self == NULL)
+    return Success;
+
+  free(self->state);
+  free(self);
+
+  return Success;
+}
+
+void DSP_Biquad_Reset(DSP_Biquad_DS *const self)
+{
+  for (size_t i = 0; i < 4 * self->stages; ++i)
+    self->state[i] = 0;
+}
+
+void DSP_Biquad_Process(DSP_Biquad_DS *const self, const q15_t in[], size_t stride, q15_t out[], size_t len)
+{
+  const uint8_t scale = 15 - self->shift;
+
+  // ? stage by stage over the whole block, coefficients stay in registers
+  for (size_t s = 0; s < self->stages; ++s)
+  {
+    const q15_t *const c = &self->coeffs[5 * s];
+    q15_t *const z = &self->state[4 * s];
+
+    const q15_t *x = (s == 0) ? in : out;
+    const size_t step = (s == 0) ? stride : 1;
+
+    sint32_t x1 = z[0], x2 = z[1], y1 = z[2], y2 = z[3];
+
+    for (size_t n = 0; n < len; ++n)
+    {
+      const sint32_t x0 = x[n * step];
+
+      sint64_t acc = (sint64_t)c[0] * x0;
+      acc += (sint64_t)c[1] * x1;
+      acc += (sint64_t)c[2] * x2;
+      acc -= (sint64_t)c[3] * y1;
+      acc -= (sint64_t)c[4] * y2;
+
+      const q15_t y0 = _DSP_Saturate((acc + _BIT(scale - 1)) >> scale);
+
+      x2 = x1;
+      x1 = x0;
+      y2 = y1;
+      y1 = y0;
+
+      out[n] = y0;
+    }
+
+    z[0] = (q15_t)x1;
+    z[1] = (q15_t)x2;
+    z[2] = (q15_t)y1;
+    z[3] = (q15_t)y2;
+  }
+}
+
+// ? Moving Average ----------------------------------------------------------------------------
+DSP_Average_DS *DSP_Average_Constructor(size_t size)
+{
+  if (size == 0 || size > 0xFFFF)
+    return NULL;
+
+  DSP_Average_DS *obj = (DSP_Average_DS *)calloc(1, sizeof(DSP_Average_DS));
+
+  if (obj == NULL)
+    return NULL;
+
+  obj->window = (q15_t *)calloc(size, sizeof(q15_t));
+
+  if (obj->window == NULL)
+  {
+    free(obj);
+    return NULL;
+  }
+
+  obj->size = size;
+  DSP_Average_Reset(obj);
+
+  return obj;
+}
+
+task_t DSP_Average_Destructor(DSP_Average_DS *const self)
+{
+  if (self == NULL)
+    return Success;
+
+  free(self->window);
+  free(self);
+
+  return Success;
+}
+
+void DSP_Average_Reset(DSP_Average_DS *const self)
+{
+  self->index = self->count = 0;
+  self->sum = 0;
+}
+
+void DSP_Average_Process(DSP_Average_DS *const self, const q15_t in[], size_t stride, q15_t out[], size_t len)
+{
+  for (size_t n = 0; n < len; ++n)
+  {
+    const q15_t x = in[n * stride];
+
+    // ? running sum: add the newest, drop the oldest
+    if (self->count == self->size)
+      self->sum -= self->window[self->index];
+    else
+      self->count++;
+
+    self->sum += x;
+    self->window[self->index] = x;
+    self->index = (self->index + 1 == self->size) ? 0 : self->index + 1;
+
+    out[n] = (q15_t)(self->sum / (sint32_t)self->count);
+  }
+}
+
+// ? CIC ---------------------------------------------------------------------------------------
+DSP_CIC_DS *DSP_CIC_Constructor(uint8_t order, size_t ratio)
+{
+  if (order == 0 || order > 4 || ratio < 2 || _MASK(ratio, ratio - 1))
+    return NULL;
+
+  uint8_t bits = 0;
+  while (_BIT(bits) < ratio)
+    bits++;
+
+  // ? bit growth must fit in 32 bits with 16 bits input
+  if (order * bits > 16)
+    return NULL;
+
+  DSP_CIC_DS *obj = (DSP_CIC_DS *)calloc(1, sizeof(DSP_CIC_DS));
+
+  if (obj == NULL)
+    return NULL;
+
+  obj->order = order;
+  obj->shift = order * bits;
+  obj->ratio = ratio;
+
+  DSP_CIC_Reset(obj);
+
+  return obj;
+}
+
+task_t DSP_CIC_Destructor(DSP_CIC_DS *const self)
+{
+  free(self);
+
+  return Success;
+}
+
+void DSP_CIC_Reset(DSP_CIC_DS *const self)
+{
+  for (size_t i = 0; i < 4; ++i)
+    self->integrator[i] = self->comb[i] = 0;
+
+  self->phase = 0;
+}
+
+task_t DSP_CIC_Process(DSP_CIC_DS *const self, const q15_t in[], size_t stride, size_t len, q15_t out[], size_t capacity, size_t *const count)
+{
+  *count = 0;
+
+  for (size_t n = 0; n < len; ++n)
+  {
+    uint32_t y = (uint32_t)(sint32_t)in[n * stride];
+
+    for (uint8_t k = 0; k < self->order; ++k)
+      y = self->integrator[k] += y;
+
+    if (++self->phase < self->ratio)
+      continue;
+
+    self->phase = 0;
+
+    for (uint8_t k = 0; k < self->order; ++k)
+    {
+      const uint32_t delayed = self->comb[k];
+      self->comb[k] = y;
+      y -= delayed;
+    }
+
+    if (*count == capacity)
+      return Fail;
+
+    out[(*count)++] = _DSP_Saturate((sint32_t)y >> self->shift);
+  }
+
+  return Success;
+}
+
+// ? Statistics --------------------------------------------------------------------------------
+task_t DSP_Stats(const q15_t in[], size_t stride, size_t len, DSP_Stats_t *const stats)
+{
+  if (len == 0)
+    return Fail;
+
+  q15_t min = in[0], max = in[0];
+  sint64_t sum = 0;
+  uint64_t square = 0;
+
+  for (size_t n = 0; n < len; ++n)
+  {
+    const q15_t x = in[n * stride];
+
+    if (x < min)
+      min = x;
+    if (x > max)
+      max = x;
+
+    sum += x;
+    square += (uint32_t)(x * x);
+  }
+
+  stats->min = min;
+  stats->max = max;
+  stats->mean = (q15_t)(sum / (sint64_t)len);
+  stats->rms = _DSP_Saturate(Fusion_Sqrt((uint32_t)(square / len)));
+
+  return Success;
+}
+
+/* ---------------------------------------------------------------- Class Public Functions End */
+
+#endif // STM32F103xx_UNREADY
@@ -0,0 +1,147 @@
+#include "Display.h"
+#include "Format.h"
+#include <stdlib.h>
+
+#ifndef STM32F103xx_UNREADY
+
+/** Class Private Functions Begin ---------------------------------------------------------------
+ * @brief
+ *
+ */
+
+/**
+ * @brief glyphs of the hex digits
+ *
+ */
+static const flag8_t _Display_Hex[16] = {
+    Num0, Num1, Num2, Num3, Num4, Num5, Num6, Num7, Num8, Num9,
+    SegA | SegB | SegC | SegE | SegF | SegG, // A
+    SegC | SegD | SegE | SegF | SegG,        // b
+    SegA | SegD | SegE | SegF,               // C
+    SegB | SegC | SegD | SegE | SegG,        // d
+    SegA | SegD | SegE | SegF | SegG,        // E
+    SegA | SegE | SegF | SegG                // F
+};
+
+/* ---------------------------------------------------------------- Class Private Functions End */
+
+/** Class Public Functions Begin ---------------------------------------------------------------
+ * @brief
+ *
+ */
+
+Display_DS *Display_Constructor(const port_t common[], size_t count, const port_t io[])
+{
+  if (count == 0)
+    return NULL;
+
+  Display_DS *obj = (Display_DS *)calloc(1, sizeof(Display_DS));
+
+  if (obj == NULL)
+    return NULL;
+
+  obj->digit = (SevenSegment_DS **)calloc(count, sizeof(SevenSegment_DS *));
+  obj->frame = (flag8_t *)calloc(2 * count, sizeof(flag8_t));
+
+  if (obj->digit == NULL || obj->frame == NULL)
+  {
+    free(obj->digit);
+    free(obj->frame);
+    free(obj);
+    return NULL;
+  }
+
+  obj->count = count;
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    obj->digit[i] = SevenSegment_Constructor(&common[i], io);
+
+    if (obj->digit[i] == NULL)
+    {
+      Display_Destructor(obj);
+      return NULL;
+    }
+
+    SevenSegment_Reset(obj->digit[i]);
+  }
+
+  // ? calloc: both buffers blank
+  obj->front = &obj->frame[0];
+  obj->back = &obj->frame[count];
+  obj->position = 0;
+
+  return obj;
+}
+
+task_t Display_Destructor(Display_DS *const self)
+{
+  for (size_t i = 0; i < self->count; ++i)
+    if (self->digit[i])
+      SevenSegment_Destructor(self->digit[i]);
+
+  free(self->digit);
+  free(self->frame);
+  free(self);
+
+  return Success;
+}
+
+task_t Display_Glyph(Display_DS *const self, size_t position, flag8_t glyph)
+{
+  if (position >= self->count)
+    return Fail;
+
+  self->back[position] = glyph;
+
+  return Success;
+}
+
+task_t Display_Digit(Display_DS *const self, size_t position, uint8_t value, bool_t isPoint)
+{
+  if (value > 0x0F)
+    return Fail;
+
+  return Display_Glyph(self, position, isPoint ? (flag8_t)(_Display_Hex[value] | SegP) : _Display_Hex[value]);
+}
+
+task_t Display_Unsigned(Display_DS *const self, uint32_t value, size_t point)
+{
+  for (size_t i = 0; i < self->count; ++i)
+  {
+    uint8_t digit;
+    value = Format_Div10(value, &digit);
+    self->back[i] = (i == point) ? (flag8_t)(_Display_Hex[digit] | SegP) : _Display_Hex[digit];
+  }
+
+  return Success;
+}
+
+task_t Display_Show(Display_DS *const self)
+{
+  flag8_t *const shown = self->back;
+
+  // ? one word write: a scan takes its glyph from a whole frame, never from one half written
+  self->back = self->front;
+  self->front = shown;
+
+  // ? the back buffer starts from the frame shown, a writer may change one digit only
+  for (size_t i = 0; i < self->count; ++i)
+    self->back[i] = shown[i];
+
+  return Success;
+}
+
+void Display_Scan(Display_DS *const self)
+{
+  SevenSegment_Reset(self->digit[self->position]);
+
+  // ? no division in the interrupt
+  self->position = (self->position + 1 == self->count) ? 0 : self->position + 1;
+
+  SevenSegment_Set(self->digit[self->position], self->front[self->position]);
+}
+
+/* ---------------------------------------------------------------- Class Public Functions End */
+
+#endif // STM32F103xx_UNREADY
@@ -0,0 +1,158 @@
+#include "Format.h"
+
+#ifndef STM32F103xx_UNREADY
+
+/** Class Private Functions Begin ---------------------------------------------------------------
+ * @brief
+ *
+ */
+
+/**
+ * @brief digits of a magnitude, lowest first
+ *
+ * @param reverse: save the characters, FORMAT_MAX_TEXT at least
+ * @param value: magnitude
+ * @return size_t: digits saved, 1 at least
+ */
+static size_t _Format_Digits(uint8_t reverse[], uint32_t value)
+{
+  size_t len = 0;
+
+  do
+  {
+    uint8_t digit;
+    value = Format_Div10(value, &digit);
+    reverse[len++] = '0' + digit;
+  } while (value);
+
+  return len;
+}
+
+/**
+ * @brief write sign, padding & reversed characters into the span
+ *
+ * @param str: span to write
+ * @param size: length of str
+ * @param reverse: characters, lowest first
+ * @param len: length of reverse
+ * @param isNegative: '-' in front
+ * @param width: min characters
+ * @param pad: ' ' (before the sign) or '0' (after the sign)
+ * @return size_t: characters written, 0 -> not enough space
+ */
+static size_t _Format_Emit(uint8_t str[], size_t size, const uint8_t reverse[], size_t len, bool_t isNegative, size_t width, uint8_t pad)
+{
+  const size_t body = len + (isNegative ? 1 : 0);
+  const size_t total = (width > body) ? width : body;
+
+  if (total > size)
+    return 0;
+
+  size_t index = 0;
+
+  if (pad != '0')
+    while (index < total - body)
+      str[index++] = pad;
+
+  if (isNegative)
+    str[index++] = '-';
+
+  while (index < total - len)
+    str[index++] = '0';
+
+  while (len)
+    str[index++] = reverse[--len];
+
+  return total;
+}
+
+/* ---------------------------------------------------------------- Class Private Functions End */
+
+/** Class Public Functions Begin ---------------------------------------------------------------
+ * @brief
+ *
+ */
+
+uint32_t Format_Div10(uint32_t value, uint8_t *const digit)
+{
+  // ? 0xCCCCCCCD = ceil(2^35 / 10), the error stays below 1 / 10 for every 32 bits dividend
+  const uint32_t quotient = (uint32_t)(((uint64_t)value * 0xCCCCCCCDU) >> 35);
+
+  if (digit)
+    *digit = (uint8_t)(value - quotient * 10);
+
+  return quotient;
+}
+
+size_t Format_Unsigned(uint8_t str[], size_t size, uint32_t value, size_t width, uint8_t pad)
+{
+  uint8_t reverse[FORMAT_MAX_TEXT];
+
+  return _Format_Emit(str, size, reverse, _Format_Digits(reverse, value), False, width, pad);
+}
+
+size_t Format_Signed(uint8_t str[], size_t size, sint32_t value, size_t width, uint8_t pad)
+{
+  uint8_t reverse[FORMAT_MAX_TEXT];
+
+  // ? through uint32_t: the magnitude of INT32_MIN does not fit in sint32_t
+  const uint32_t magnitude = (value < 0) ? 0U - (uint32_t)value : (uint32_t)value;
+
+  return _Format_Emit(str, size, reverse, _Format_Digits(reverse, magnitude), (value < 0) ? True : False, width, pad);
+}
+
+size_t Format_Fixed(uint8_t str[], size_t size, sint32_t value, uint8_t decimals, size_t width)
+{
+  if (decimals > 9)
+    return 0;
+
+  uint8_t reverse[FORMAT_MAX_TEXT];
+  uint32_t magnitude = (value < 0) ? 0U - (uint32_t)value : (uint32_t)value;
+  size_t len = 0;
+
+  // ? fraction first, leading zeros kept: 5, 2 -> "0.05"
+  for (uint8_t i = 0; i < decimals; ++i)
+  {
+    uint8_t digit;
+    magnitude = Format_Div10(magnitude, &digit);
+    reverse[len++] = '0' + digit;
+  }
+
+  if (decimals)
+    reverse[len++] = '.';
+
+  len += _Format_Digits(&reverse[len], magnitude);
+
+  return _Format_Emit(str, size, reverse, len, (value < 0) ? True : False, width, ' ');
+}
+
+size_t Format_Hex(uint8_t str[], size_t size, uint32_t value, size_t digits)
+{
+  static const uint8_t nibble[16] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
+
+  uint8_t reverse[FORMAT_MAX_TEXT];
+  size_t len = 0;
+
+  do
+  {
+    reverse[len++] = nibble[value & 0x0F];
+    value >>= 4;
+  } while (value);
+
+  return _Format_Emit(str, size, reverse, len, False, digits, '0');
+}
+
+task_t Format_Push(Buffer_DS *const buffer, const uint8_t str[], size_t len)
+{
+  if (len == 0 || Buffer_Space(buffer) < len)
+    return Fail;
+
+  for (size_t i = 0; i < len; ++i)
+    Buffer_Push(buffer, str[i]);
+
+  return Success;
+}
+
+/* ---------------------------------------------------------------- Class Public Functions End */
+
+#endif // STM32F103xx_UNREADY
@@ -0,0 +1,245 @@
+#include "Fusion.h"
+#include <stdlib.h>
+
+#ifndef STM32F103xx_UNREADY
+
+/** Def. Begin -------------------------------------------------------------------------
+ * @brief
+ *
+ */
+
+#define FUSION_HALF_RAD_Q64 160979U   // * pi / 180 / 2e12 in Q64: udps * us -> half rad
+#define FUSION_HALF_SEC_Q46 35184372U // * 2^30 / 2e6 in Q16: us -> half second in Q30
+
+/* -------------------------------------------------------------------------- Def. End */
+
+/** Class Private Functions Begin ---------------------------------------------------------------
+ * @brief
+ *
+ */
+
+/**
+ * @brief pull the quaternion back to unit length
+ * | one Newton step of 1 / sqrt(s) around 1: q *= (3 - s) / 2
+ *
+ * @param self: object pointer
+ */
+static void _Fusion_Normalize(Fusion_DS *const self)
+{
+  sint64_t s = 0;
+
+  for (size_t i = 0; i < 4; ++i)
+    s += (sint64_t)self->q[i] * self->q[i];
+
+  const sint64_t factor = (3 * (sint64_t)FUSION_ONE_Q30 - (s >> 30)) >> 1;
+
+  for (size_t i = 0; i < 4; ++i)
+    self->q[i] = (q31_t)(((sint64_t)self->q[i] * factor) >> 30);
+}
+
+/**
+ * @brief saturate into Q15
+ *
+ * @param value: Q15 value in 32 bits
+ * @return q15_t: -32768 ~ 32767
+ */
+static inline q15_t _Fusion_Q15(const sint32_t value)
+{
+  if (value > 32767)
+    return 32767;
+  if (value < -32768)
+    return -32768;
+
+  return (q15_t)value;
+}
+
+/* ---------------------------------------------------------------- Class Private Functions End */
+
+/** Class Public Functions Begin ---------------------------------------------------------------
+ * @brief
+ *
+ */
+
+Fusion_DS *Fusion_Constructor(const Fusion_Config_t *const config)
+{
+  if (config->gyroScale == 0 || config->kp < 0 || config->ki < 0)
+    return NULL;
+
+  Fusion_DS *obj = (Fusion_DS *)calloc(1, sizeof(Fusion_DS));
+
+  if (obj == NULL)
+    return NULL;
+
+  obj->step = (uint32_t)(((uint64_t)config->gyroScale * FUSION_HALF_RAD_Q64) >> 8);
+  obj->kp = config->kp;
+  obj->ki = config->ki;
+
+  Fusion_Reset(obj);
+
+  // ? DWT cycle counter for the cycle budget
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  obj->cycles.last = 0;
+  obj->cycles.max = 0;
+
+  return obj;
+}
+
+task_t Fusion_Destructor(Fusion_DS *const self)
+{
+  free(self);
+
+  return Success;
+}
+
+void Fusion_Reset(Fusion_DS *const self)
+{
+  self->q[0] = FUSION_ONE_Q30;
+  self->q[1] = self->q[2] = self->q[3] = 0;
+
+  for (size_t i = 0; i < 3; ++i)
+    self->integral[i] = 0;
+}
+
+task_t Fusion_Update(Fusion_DS *const self, const sint16_t gyro[3], const sint16_t acce[3], uint32_t dt)
+{
+  const uint32_t begin = DWT->CYCCNT;
+
+  if (dt == 0 || dt > 1000000)
+    return Fail;
+
+  const sint64_t halfDt = (sint64_t)(((uint64_t)dt * FUSION_HALF_SEC_Q46) >> 16); // Q30 second
+  sint32_t feedback[3] = {0};                                                      // Q15 rad/s
+
+  // ? |acce| ^ 2 < 3 * 2^30, no overflow in 32 bits
+  const uint32_t norm2 =
+      (uint32_t)(acce[0] * acce[0]) + (uint32_t)(acce[1] * acce[1]) + (uint32_t)(acce[2] * acce[2]);
+
+  if (norm2 != 0)
+  {
+    const sint32_t norm = (sint32_t)Fusion_Sqrt(norm2);
+    const sint32_t a[3] = {(acce[0] * 32768) / norm, (acce[1] * 32768) / norm, (acce[2] * 32768) / norm};
+
+    q15_t v[3] = {0};
+    Fusion_GetGravity(self, v);
+
+    // error = measured x estimated gravity, Q15
+    const sint32_t error[3] = {
+        ((a[1] * v[2]) >> 15) - ((a[2] * v[1]) >> 15),
+        ((a[2] * v[0]) >> 15) - ((a[0] * v[2]) >> 15),
+        ((a[0] * v[1]) >> 15) - ((a[1] * v[0]) >> 15)};
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+      if (self->ki)
+        self->integral[i] += (q31_t)(((((sint64_t)self->ki * error[i]) >> 16) * (2 * halfDt)) >> 30);
+
+      feedback[i] = (sint32_t)(((sint64_t)self->kp * error[i]) >> 16) + self->integral[i];
+    }
+  }
+
+  // half angle of this step, Q30: gyro * step * dt + feedback * dt / 2
+  const sint64_t k = (sint64_t)(((uint64_t)self->step * dt) >> 16); // Q40 half rad per LSB
+  sint64_t t[3] = {0};
+
+  for (size_t i = 0; i < 3; ++i)
+    t[i] = (((sint64_t)gyro[i] * k) >> 10) + (((sint64_t)feedback[i] * halfDt) >> 15);
+
+  const sint64_t w = self->q[0], x = self->q[1], y = self->q[2], z = self->q[3];
+
+  // q += q * (0, t)
+  self->q[0] = (q31_t)(w + ((-x * t[0] - y * t[1] - z * t[2]) >> 30));
+  self->q[1] = (q31_t)(x + ((w * t[0] + y * t[2] - z * t[1]) >> 30));
+  self->q[2] = (q31_t)(y + ((w * t[1] - x * t[2] + z * t[0]) >> 30));
+  self->q[3] = (q31_t)(z + ((w * t[2] + x * t[1] - y * t[0]) >> 30));
+
+  _Fusion_Normalize(self);
+
+  self->cycles.last = DWT->CYCCNT - begin;
+  if (self->cycles.last > self->cycles.max)
+    self->cycles.max = self->cycles.last;
+
+  return Success;
+}
+
+void Fusion_GetQuaternion(Fusion_DS *const self, q31_t q[4])
+{
+  for (size_t i = 0; i < 4; ++i)
+    q[i] = self->q[i];
+}
+
+void Fusion_GetEuler(Fusion_DS *const self, sint16_t *const roll, sint16_t *const pitch)
+{
+  q15_t v[3] = {0};
+  Fusion_GetGravity(self, v);
+
+  const uint32_t horizon = Fusion_Sqrt((uint32_t)(v[1] * v[1]) + (uint32_t)(v[2] * v[2]));
+
+  *roll = Fusion_Atan2(v[1], v[2]);
+  *pitch = Fusion_Atan2(-v[0], (sint32_t)horizon);
+}
+
+void Fusion_GetGravity(Fusion_DS *const self, q15_t gravity[3])
+{
+  const sint64_t w = self->q[0], x = self->q[1], y = self->q[2], z = self->q[3];
+
+  // ? third row of the rotation matrix, Q60 -> Q15
+  gravity[0] = _Fusion_Q15((sint32_t)((x * z - w * y) >> 44));
+  gravity[1] = _Fusion_Q15((sint32_t)((w * x + y * z) >> 44));
+  gravity[2] = _Fusion_Q15((sint32_t)((w * w - x * x - y * y + z * z) >> 45));
+}
+
+sint16_t Fusion_Atan2(sint32_t y, sint32_t x)
+{
+  const uint32_t ux = (uint32_t)((x < 0) ? -x : x);
+  const uint32_t uy = (uint32_t)((y < 0) ? -y : y);
+
+  if (ux == 0 && uy == 0)
+    return 0;
+
+  // ? fold into 0 ~ 45 degree, z = tan in Q15
+  const bool_t isSteep = (uy > ux) ? True : False;
+  const uint32_t z = isSteep ? ((ux << 15) / uy) : ((uy << 15) / ux);
+
+  // atan(z) ~ pi / 4 * z + z * (1 - z) * (0.2447 + 0.0663 * z), in 0.01 degree
+  const uint32_t t = (z * (32768 - z)) >> 15;
+  sint32_t angle = (sint32_t)(((4500 * z) >> 15) + ((t * (1402 + ((380 * z) >> 15))) >> 15));
+
+  if (isSteep)
+    angle = 9000 - angle;
+
+  if (x < 0)
+    angle = 18000 - angle;
+
+  return (sint16_t)((y < 0) ? -angle : angle);
+}
+
+uint32_t Fusion_Sqrt(uint32_t n)
+{
+  uint32_t root = 0;
+  uint32_t bit = _BIT(30);
+
+  while (bit > n)
+    bit >>= 2;
+
+  while (bit)
+  {
+    if (n >= root + bit)
+    {
+      n -= root + bit;
+      root = (root >> 1) + bit;
+    }
+    else
+    {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+
+  return root;
+}
+
+/* ---------------------------------------------------------------- Class Public Functions End */
+
+#endif // STM32F103xx_UNREADY
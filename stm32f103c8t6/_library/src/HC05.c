@@ -1,13 +1,202 @@
 #include "HC05.h"
+#include "Format.h"
 #include <stdlib.h>
 
 #ifndef STM32F103xx_UNREADY
 
+/** Def. Begin -------------------------------------------------------------------------
+ * @brief
+ *
+ */
+
+// * rates of AT+UART, ascending
+static const uint32_t _HC05_BaudTable[] = {9600, 19200, 38400, 57600, 115200, 230400, 460800, 921600, 1382400};
+
+#define HC05_BAUD_COUNT (sizeof(_HC05_BaudTable) / sizeof(_HC05_BaudTable[0]))
+
+/* -------------------------------------------------------------------------- Def. End */
+
 /** Class Private Functions Begin ---------------------------------------------------------------
  * @brief
  *
  */
 
+/**
+ * @brief start the DMA with the contiguous region at the head of the buffer
+ * @warning called with interrupts masked or from the TX DMA interrupt
+ *
+ * @param self: object pointer
+ */
+static void _HC05_Kick(HC05_DS *const self)
+{
+  if (self->tx.isBusy)
+    return;
+
+  const uint8_t *region = NULL;
+  size_t len = Buffer_Region(self->tx.buffer, &region);
+
+  // ? only ended messages go out, a message in the making is never started
+  if (len > self->tx.marked - self->tx.done)
+    len = self->tx.marked - self->tx.done;
+
+  if (len == 0)
+    return;
+
+  if (len > 0xFFFF)
+    len = 0xFFFF;
+
+  _InterfaceDMA_Disable(self->tx.channel);
+  _InterfaceDMA_Clear(self->DMAx, self->tx.order, DMA_GIF | DMA_TCIF | DMA_HTIF | DMA_TEIF);
+
+  if (_InterfaceDMA_Config(self->tx.channel, &self->USARTx->DR, region, len, DMA_MEM2PER | DMA_MINC | DMA_TCIE | DMA_TEIE) != Success)
+    return;
+
+  self->tx.length = len;
+  self->tx.isBusy = True;
+
+  _InterfaceDMA_Enable(self->tx.channel);
+}
+
+/**
+ * @brief end the message pushed since the last mark
+ * @warning called with interrupts masked
+ *
+ * @param self: object pointer
+ */
+static void _HC05_Mark(HC05_DS *const self)
+{
+  const size_t fresh = Buffer_Length(self->tx.buffer) - (self->tx.marked - self->tx.done);
+
+  if (fresh == 0)
+    return;
+
+  if (self->tx.count == HC05_TX_MARKS)
+  {
+    self->tx.marks[(self->tx.first + self->tx.count - 1) % HC05_TX_MARKS] += fresh;
+  }
+  else
+  {
+    self->tx.marks[(self->tx.first + self->tx.count) % HC05_TX_MARKS] = fresh;
+    self->tx.count++;
+  }
+
+  self->tx.marked += fresh;
+}
+
+/**
+ * @brief drop the marks of the bytes sent by the DMA
+ * @warning called from the TX DMA interrupt
+ *
+ * @param self: object pointer
+ * @param len: bytes sent
+ */
+static void _HC05_Consume(HC05_DS *const self, size_t len)
+{
+  self->tx.done += len;
+
+  while (self->tx.count && self->tx.done >= self->tx.marks[self->tx.first])
+  {
+    self->tx.done -= self->tx.marks[self->tx.first];
+    self->tx.marked -= self->tx.marks[self->tx.first];
+    self->tx.first = (self->tx.first + 1) % HC05_TX_MARKS;
+    self->tx.count--;
+  }
+}
+
+/**
+ * @brief remove whole messages not started by the DMA, oldest first, until there is room
+ * @warning called with interrupts masked
+ *
+ * @param self: object pointer
+ * @param len: bytes needed
+ */
+static void _HC05_DropOldest(HC05_DS *const self, size_t len)
+{
+  size_t start = 0; // from the head of the buffer
+  size_t k = 0;
+
+  // ? skip the oldest message once any of it is sent, & every one the region in flight reaches
+  while (k < self->tx.count)
+  {
+    const size_t index = (self->tx.first + k) % HC05_TX_MARKS;
+
+    if (start >= self->tx.length && !(k == 0 && self->tx.done))
+      break;
+
+    start += self->tx.marks[index] - ((k == 0) ? self->tx.done : 0);
+    k++;
+  }
+
+  while (k < self->tx.count && Buffer_Space(self->tx.buffer) < len)
+  {
+    const size_t size = self->tx.marks[(self->tx.first + k) % HC05_TX_MARKS];
+
+    Buffer_Cut(self->tx.buffer, start, size);
+
+    for (size_t i = k; i + 1 < self->tx.count; ++i)
+      self->tx.marks[(self->tx.first + i) % HC05_TX_MARKS] = self->tx.marks[(self->tx.first + i + 1) % HC05_TX_MARKS];
+
+    self->tx.count--;
+    self->tx.marked -= size;
+    self->tx.dropped++;
+  }
+}
+
+/**
+ * @brief count the bytes written by the DMA since the last collect
+ * @warning called with interrupts masked or from the RX interrupts
+ *
+ * @param self: object pointer
+ */
+static void _HC05_Collect(HC05_DS *const self)
+{
+  size_t position = self->rx.size - _InterfaceDMA_Remaining(self->rx.channel);
+
+  if (position == self->rx.size)
+    position = 0;
+
+  const size_t fresh = (position >= self->rx.last) ? (position - self->rx.last) : (position + self->rx.size - self->rx.last);
+
+  self->rx.last = position;
+
+  // ? HT & TC bound the gap to half a ring, a lap is never missed
+  if (self->rx.pending + fresh > self->rx.size)
+  {
+    self->rx.pending = self->rx.size;
+    self->rx.isOverrun = True;
+  }
+  else
+  {
+    self->rx.pending += fresh;
+  }
+}
+
+/**
+ * @brief APB clock of the USART
+ *
+ * @param self: object pointer
+ * @return uint32_t: Hz
+ */
+static uint32_t _HC05_Clock(HC05_DS *const self)
+{
+  return _APBClock(self->USARTx == USART1 ? True : False);
+}
+
+/**
+ * @brief check a rate against the ones of AT+UART
+ *
+ * @param baud: bit/s
+ * @return bool_t: True (the module takes it) / False
+ */
+static bool_t _HC05_isBaud(uint32_t baud)
+{
+  for (size_t i = 0; i < HC05_BAUD_COUNT; ++i)
+    if (_HC05_BaudTable[i] == baud)
+      return True;
+
+  return False;
+}
+
 /* ---------------------------------------------------------------- Class Private Functions End */
 
 /** Class Public Functions Begin ---------------------------------------------------------------
@@ -23,12 +212,65 @@ HC05_DS *HC05_Constructor(USART_TypeDef *USARTx)
     return NULL;
 
   obj->USARTx = USARTx;
+  obj->DMAx = DMA1;
+
+  // ? the rate set up by the user, read back from the divider
+  obj->baud = USARTx->BRR ? _HC05_Clock(obj) / USARTx->BRR : 0;
+
+  if (USARTx == USART1)
+  {
+    obj->tx.channel = DMA1_Channel4;
+    obj->tx.order = 4;
+    obj->rx.channel = DMA1_Channel5;
+    obj->rx.order = 5;
+  }
+  else if (USARTx == USART2)
+  {
+    obj->tx.channel = DMA1_Channel7;
+    obj->tx.order = 7;
+    obj->rx.channel = DMA1_Channel6;
+    obj->rx.order = 6;
+  }
+  else
+  {
+    obj->tx.channel = DMA1_Channel2;
+    obj->tx.order = 2;
+    obj->rx.channel = DMA1_Channel3;
+    obj->rx.order = 3;
+  }
+
+  obj->tx.buffer = NULL;
+  obj->tx.length = 0;
+  obj->tx.isBusy = False;
+  obj->tx.first = obj->tx.count = obj->tx.marked = obj->tx.done = 0;
+  obj->tx.dropped = 0;
+
+  obj->rx.array = NULL;
+  obj->rx.size = obj->rx.last = obj->rx.pending = 0;
+  obj->rx.isFrame = obj->rx.isOverrun = False;
 
   return obj;
 }
 
 task_t HC05_Destructor(HC05_DS *self)
 {
+  if (self == NULL)
+    return Success;
+
+  if (self->tx.buffer)
+  {
+    _InterfaceDMA_Disable(self->tx.channel);
+    self->USARTx->CR3 &= ~_BIT(7); // disable DMAT
+  }
+
+  if (self->rx.array)
+  {
+    _InterfaceDMA_Disable(self->rx.channel);
+    self->USARTx->CR1 &= ~_BIT(4); // disable IDLEIE
+    self->USARTx->CR3 &= ~_BIT(6); // disable DMAR
+    free(self->rx.array);
+  }
+
   free(self);
 
   return Success;
@@ -56,6 +298,396 @@ task_t HC05_RxByte(HC05_DS *const self, volatile uint8_t *byte, uint16_t timeout
   return Fail;
 }
 
+task_t HC05_SetBaud(HC05_DS *const self, uint32_t baud)
+{
+  if (baud == 0)
+    return Fail;
+
+  // ? 16 x oversampling: BRR holds clock / baud in 12.4 fixed-point, which is the plain quotient
+  const uint32_t clock = _HC05_Clock(self);
+  const uint32_t divider = (clock + baud / 2) / baud;
+
+  if (divider < 16 || divider > 0xFFFF)
+    return Fail;
+
+  // wait for TC, the last byte leaves at the old rate
+  for (uint32_t tries = 0xFFFF; !_MASK(self->USARTx->SR, _BIT(6)) && tries; --tries)
+  {
+  }
+
+  self->USARTx->CR1 &= ~_BIT(13); // disable UE
+  self->USARTx->BRR = divider;
+  self->USARTx->CR1 |= _BIT(13); // enable UE
+
+  self->baud = baud;
+
+  return Success;
+}
+
+task_t HC05_Command(HC05_DS *const self, const uint8_t cmd[], size_t len, uint32_t timeout)
+{
+  // ? polling, the DMA owns DR once attached
+  if (self->tx.buffer || self->rx.array)
+    return Fail;
+
+  volatile uint8_t byte = 0;
+
+  // drop stale bytes & clear ORE / FE (read SR then DR)
+  while (_MASK(self->USARTx->SR, _BIT(5) | _BIT(3) | _BIT(1)))
+    byte = (uint8_t)self->USARTx->DR;
+
+  for (size_t i = 0; i < len; ++i)
+    if (HC05_TxByte(self, cmd[i], 0xFFFF) != Success)
+      return Fail;
+
+  if (HC05_TxByte(self, '\r', 0xFFFF) != Success || HC05_TxByte(self, '\n', 0xFFFF) != Success)
+    return Fail;
+
+  // ? answer lines (+NAME:...) come before the status line, only the head of each line is kept
+  uint8_t line[5] = {0};
+  size_t count = 0;
+
+  while (count < 0x40 + sizeof(line))
+  {
+    uint32_t tries = timeout;
+
+    while (_InterfaceUSART_RxByte(self->USARTx, &byte) != Success)
+      if (tries-- == 0)
+        return Fail;
+
+    if (byte == '\n')
+    {
+      if (count >= 2 && line[0] == 'O' && line[1] == 'K')
+        return Success;
+
+      // ERROR:(n) / FAIL, or an answer line
+      if (count >= 4 && (line[0] == 'E' || line[0] == 'F'))
+        return Fail;
+
+      count = 0;
+      continue;
+    }
+
+    if (count < sizeof(line))
+      line[count] = byte;
+
+    // ? a wrong rate turns the answer into endless garbage without line ends
+    count++;
+  }
+
+  return Fail;
+}
+
+task_t HC05_SetModuleBaud(HC05_DS *const self, uint32_t baud, uint32_t timeout)
+{
+  if (!_HC05_isBaud(baud))
+    return Fail;
+
+  const uint32_t origin = self->baud;
+
+  // ? full AT mode listens at 38400 whatever its data rate is
+  if (HC05_SetBaud(self, HC05_AT_BAUD) != Success)
+    return Fail;
+
+  // AT+UART=<baud>,0,0: 1 stop bit, no parity
+  uint8_t cmd[20] = {'A', 'T', '+', 'U', 'A', 'R', 'T', '='};
+  size_t len = 8;
+
+  len += Format_Unsigned(&cmd[len], sizeof(cmd) - len, baud, 0, ' ');
+
+  cmd[len++] = ',';
+  cmd[len++] = '0';
+  cmd[len++] = ',';
+  cmd[len++] = '0';
+
+  if (HC05_Command(self, (const uint8_t *)"AT", 2, timeout) != Success ||
+      HC05_Command(self, cmd, len, timeout) != Success ||
+      HC05_Command(self, (const uint8_t *)"AT+RESET", 8, timeout) != Success)
+  {
+    HC05_SetBaud(self, origin);
+    return Fail;
+  }
+
+  // ? back in data mode after the reset, nothing answers AT there: the new rate is taken as is
+  return HC05_SetBaud(self, baud);
+}
+
+task_t HC05_SetFlowControl(HC05_DS *const self, bool_t isEnabled)
+{
+  // wait for TC, the last byte leaves under the old setting
+  for (uint32_t tries = 0xFFFF; !_MASK(self->USARTx->SR, _BIT(6)) && tries; --tries)
+  {
+  }
+
+  self->USARTx->CR1 &= ~_BIT(13); // disable UE
+
+  if (isEnabled)
+    self->USARTx->CR3 |= (_BIT(9) | _BIT(8)); // enable CTSE & RTSE
+  else
+    self->USARTx->CR3 &= ~(_BIT(9) | _BIT(8)); // disable CTSE & RTSE
+
+  self->USARTx->CR1 |= _BIT(13); // enable UE
+
+  return Success;
+}
+
+task_t HC05_AttachTx(HC05_DS *const self, Buffer_DS *const buffer)
+{
+  if (buffer == NULL || self->tx.isBusy)
+    return Fail;
+
+  self->tx.buffer = buffer;
+  self->tx.length = 0;
+  self->tx.first = self->tx.count = self->tx.marked = self->tx.done = 0;
+
+  // ? bytes already in the buffer count as one message
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  _HC05_Mark(self);
+  __set_PRIMASK(primask);
+
+  self->USARTx->CR1 &= ~_BIT(7); // disable TXEIE
+  self->USARTx->CR3 |= _BIT(7);  // enable DMAT
+
+  return Success;
+}
+
+task_t HC05_Send(HC05_DS *const self, const uint8_t array[], size_t len)
+{
+  return HC05_SendWith(self, array, len, HC05_DROP_NEWEST, 0);
+}
+
+task_t HC05_SendWith(HC05_DS *const self, const uint8_t array[], size_t len, HC05_Policy_Enum policy, uint32_t timeout)
+{
+  // ? all or nothing, a line is never cut in the middle
+  if (HC05_Reserve(self, len, policy, timeout) != Success)
+    return Fail;
+
+  for (size_t i = 0; i < len; ++i)
+    Buffer_Push(self->tx.buffer, array[i]);
+
+  return HC05_Transmit(self);
+}
+
+task_t HC05_Reserve(HC05_DS *const self, size_t len, HC05_Policy_Enum policy, uint32_t timeout)
+{
+  if (self->tx.buffer == NULL)
+    return Fail;
+
+  // ? never fits, no policy helps
+  if (len > Buffer_Space(self->tx.buffer) + Buffer_Length(self->tx.buffer))
+    return Fail;
+
+  if (Buffer_Space(self->tx.buffer) >= len)
+    return Success;
+
+  if (policy == HC05_DROP_OLDEST)
+  {
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    _HC05_DropOldest(self, len);
+
+    __set_PRIMASK(primask);
+  }
+  else if (policy == HC05_BLOCK)
+  {
+    // ? the DMA frees room region by region, one check per try
+    do
+    {
+      if (Buffer_Space(self->tx.buffer) >= len)
+        return Success;
+
+      // ! nothing in flight (e.g. interrupts masked), no room is coming
+      if (!self->tx.isBusy)
+        return Fail;
+    } while (timeout--);
+
+    return Fail;
+  }
+
+  return (Buffer_Space(self->tx.buffer) >= len) ? Success : Fail;
+}
+
+task_t HC05_Transmit(HC05_DS *const self)
+{
+  if (self->tx.buffer == NULL)
+    return Fail;
+
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  _HC05_Mark(self);
+  _HC05_Kick(self);
+
+  __set_PRIMASK(primask);
+
+  return Success;
+}
+
+bool_t HC05_isTxIdle(HC05_DS *const self)
+{
+  if (self->tx.buffer == NULL)
+    return True;
+
+  return (!self->tx.isBusy && Buffer_Length(self->tx.buffer) == 0) ? True : False;
+}
+
+uint32_t HC05_GetBaud(HC05_DS *const self)
+{
+  return self->baud;
+}
+
+uint32_t HC05_GetDropped(HC05_DS *const self)
+{
+  return self->tx.dropped;
+}
+
+void HC05_TxIRQHandler(HC05_DS *const self)
+{
+  if (_InterfaceDMA_isFlag(self->DMAx, self->tx.order, DMA_TEIF))
+  {
+    // ? drop the broken region, go on with the rest
+    _InterfaceDMA_Clear(self->DMAx, self->tx.order, DMA_GIF | DMA_TEIF);
+  }
+  else if (_InterfaceDMA_isFlag(self->DMAx, self->tx.order, DMA_TCIF))
+  {
+    _InterfaceDMA_Clear(self->DMAx, self->tx.order, DMA_GIF | DMA_TCIF);
+  }
+  else
+  {
+    return;
+  }
+
+  _InterfaceDMA_Disable(self->tx.channel);
+
+  Buffer_Skip(self->tx.buffer, self->tx.length);
+  _HC05_Consume(self, self->tx.length);
+  self->tx.length = 0;
+  self->tx.isBusy = False;
+
+  // ? chain the next region: the wrapped part or bytes queued meanwhile
+  _HC05_Kick(self);
+}
+
+task_t HC05_AttachRx(HC05_DS *const self, size_t size)
+{
+  if (self->rx.array || size < 2 || size > 0xFFFF)
+    return Fail;
+
+  self->rx.array = (uint8_t *)calloc(size, sizeof(uint8_t));
+
+  if (self->rx.array == NULL)
+    return Fail;
+
+  self->rx.size = size;
+  self->rx.last = self->rx.pending = 0;
+  self->rx.isFrame = self->rx.isOverrun = False;
+
+  _InterfaceDMA_Disable(self->rx.channel);
+  _InterfaceDMA_Clear(self->DMAx, self->rx.order, DMA_GIF | DMA_TCIF | DMA_HTIF | DMA_TEIF);
+
+  if (_InterfaceDMA_Config(self->rx.channel, &self->USARTx->DR, self->rx.array, size, DMA_CIRC | DMA_MINC | DMA_HTIE | DMA_TCIE | DMA_TEIE | DMA_PRIO_HIGH) != Success)
+  {
+    free(self->rx.array);
+    self->rx.array = NULL;
+    return Fail;
+  }
+
+  // ? clear residual data & flags (read SR then DR)
+  volatile uint32_t temp = self->USARTx->SR;
+  temp = self->USARTx->DR;
+  (void)temp;
+
+  self->USARTx->CR1 &= ~_BIT(5); // disable RXNEIE
+  self->USARTx->CR3 |= _BIT(6);  // enable DMAR
+  _InterfaceDMA_Enable(self->rx.channel);
+  self->USARTx->CR1 |= _BIT(4); // enable IDLEIE
+
+  return Success;
+}
+
+size_t HC05_Receive(HC05_DS *const self, uint8_t array[], size_t capacity)
+{
+  if (self->rx.array == NULL)
+    return 0;
+
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  // ? bytes of a frame still in progress have no event yet
+  _HC05_Collect(self);
+
+  const size_t len = (self->rx.pending < capacity) ? self->rx.pending : capacity;
+  const size_t first = (self->rx.last + self->rx.size - self->rx.pending) % self->rx.size;
+
+  __set_PRIMASK(primask);
+
+  for (size_t i = 0, index = first; i < len; ++i)
+  {
+    array[i] = self->rx.array[index];
+    index = (index + 1 == self->rx.size) ? 0 : index + 1;
+  }
+
+  __disable_irq();
+  self->rx.pending -= len;
+  __set_PRIMASK(primask);
+
+  return len;
+}
+
+bool_t HC05_TakeFrame(HC05_DS *const self)
+{
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  const bool_t isFrame = self->rx.isFrame;
+  self->rx.isFrame = False;
+
+  __set_PRIMASK(primask);
+
+  return isFrame;
+}
+
+bool_t HC05_TakeOverrun(HC05_DS *const self)
+{
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  const bool_t isOverrun = self->rx.isOverrun;
+  self->rx.isOverrun = False;
+
+  __set_PRIMASK(primask);
+
+  return isOverrun;
+}
+
+void HC05_RxIRQHandler(HC05_DS *const self)
+{
+  if (self->rx.array == NULL)
+    return;
+
+  // IDLE (or ORE): cleared by reading SR then DR
+  const flag32_t flag = self->USARTx->SR;
+  if (_MASK(flag, _BIT(4) | _BIT(3)))
+  {
+    volatile uint32_t temp = self->USARTx->DR;
+    (void)temp;
+
+    if (_MASK(flag, _BIT(3)))
+      self->rx.isOverrun = True;
+    if (_MASK(flag, _BIT(4)))
+      self->rx.isFrame = True;
+  }
+
+  if (_InterfaceDMA_isFlag(self->DMAx, self->rx.order, DMA_TEIF))
+    self->rx.isOverrun = True;
+
+  _InterfaceDMA_Clear(self->DMAx, self->rx.order, DMA_GIF | DMA_HTIF | DMA_TCIF | DMA_TEIF);
+
+  _HC05_Collect(self);
+}
+
 /* ---------------------------------------------------------------- Class Public Functions End */
 
 #endif // STM32F103xx_UNREADY
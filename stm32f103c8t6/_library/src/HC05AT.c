@@ -0,0 +1,240 @@
+#include "HC05AT.h"
+#include <stdlib.h>
+
+#ifndef STM32F103xx_UNREADY
+
+/** Class Private Functions Begin ---------------------------------------------------------------
+ * @brief
+ *
+ */
+
+/**
+ * @brief end the current command & notify its owner
+ *
+ * @param self: object pointer
+ * @param result: Success / Fail
+ * @param error: refer to HC05AT_ERROR_xxx
+ */
+static void _HC05AT_Complete(HC05AT_DS *const self, task_t result, uint16_t error)
+{
+  self->isWaiting = False;
+
+  // ? a cut answer is still reported, after the status of the command
+  self->reply.result = result;
+  if (error != HC05AT_ERROR_NONE || self->reply.error == HC05AT_ERROR_NONE)
+    self->reply.error = error;
+
+  if (self->current.callback)
+    self->current.callback(&self->reply, self->current.context);
+}
+
+/**
+ * @brief value of the hex digits in ERROR:(n)
+ *
+ * @param str: digits, ended by ')'
+ * @param len: length of str
+ * @return uint16_t: n
+ */
+static uint16_t _HC05AT_Hex(const uint8_t str[], size_t len)
+{
+  uint16_t value = 0;
+
+  for (size_t i = 0; i < len && str[i] != ')'; ++i)
+  {
+    const uint8_t c = str[i];
+
+    if (c >= '0' && c <= '9')
+      value = (uint16_t)((value << 4) | (c - '0'));
+    else if (c >= 'A' && c <= 'F')
+      value = (uint16_t)((value << 4) | (c - 'A' + 10));
+    else if (c >= 'a' && c <= 'f')
+      value = (uint16_t)((value << 4) | (c - 'a' + 10));
+    else
+      break;
+  }
+
+  return value;
+}
+
+/**
+ * @brief a line is complete, check if it ends the command
+ *
+ * @param self: object pointer
+ */
+static void _HC05AT_Line(HC05AT_DS *const self)
+{
+  const uint8_t *line = self->line;
+  const size_t len = (self->column < sizeof(self->line)) ? self->column : sizeof(self->line);
+
+  if (len == 2 && line[0] == 'O' && line[1] == 'K')
+    _HC05AT_Complete(self, Success, HC05AT_ERROR_NONE);
+  else if (len >= 7 && line[0] == 'E' && line[1] == 'R' && line[5] == ':' && line[6] == '(')
+    _HC05AT_Complete(self, Fail, _HC05AT_Hex(&line[7], len - 7));
+  else if (len == 4 && line[0] == 'F' && line[1] == 'A' && line[2] == 'I' && line[3] == 'L')
+    _HC05AT_Complete(self, Fail, HC05AT_ERROR_FAIL);
+
+  // ? otherwise an answer or an echo, its payload is saved already
+}
+
+/**
+ * @brief take one byte of the answer
+ *
+ * @param self: object pointer
+ * @param byte: from the module
+ */
+static void _HC05AT_Byte(HC05AT_DS *const self, const uint8_t byte)
+{
+  if (byte == '\r')
+    return;
+
+  if (byte == '\n')
+  {
+    _HC05AT_Line(self);
+    self->column = 0;
+    self->isPayload = False;
+    return;
+  }
+
+  if (self->column < sizeof(self->line))
+    self->line[self->column] = byte;
+
+  self->column++;
+
+  // ? payload after the first ':' of a +XXX: line goes straight into answer, no line buffer
+  if (self->isPayload)
+  {
+    if (self->reply.len < self->current.capacity)
+      self->current.answer[self->reply.len++] = byte;
+    else
+      self->reply.error = HC05AT_ERROR_OVERFLOW;
+  }
+  else if (byte == ':' && self->line[0] == '+' && self->current.answer)
+  {
+    self->isPayload = True;
+
+    // ? several answer lines (e.g. +INQ:) are split by a line end
+    if (self->reply.len != 0 && self->reply.len < self->current.capacity)
+      self->current.answer[self->reply.len++] = '\n';
+  }
+}
+
+/* ---------------------------------------------------------------- Class Private Functions End */
+
+/** Class Public Functions Begin ---------------------------------------------------------------
+ * @brief
+ *
+ */
+
+HC05AT_DS *HC05AT_Constructor(HC05_DS *const device, size_t depth)
+{
+  if (device == NULL || depth == 0)
+    return NULL;
+
+  HC05AT_DS *obj = (HC05AT_DS *)calloc(1, sizeof(HC05AT_DS));
+
+  if (obj == NULL)
+    return NULL;
+
+  obj->queue.array = (HC05AT_Command_t *)calloc(depth, sizeof(HC05AT_Command_t));
+
+  if (obj->queue.array == NULL)
+  {
+    free(obj);
+    return NULL;
+  }
+
+  obj->device = device;
+  obj->queue.head = obj->queue.tail = 0;
+  obj->queue.size = depth;
+  obj->column = 0;
+  obj->isPayload = obj->isWaiting = False;
+
+  return obj;
+}
+
+task_t HC05AT_Destructor(HC05AT_DS *const self)
+{
+  if (self == NULL)
+    return Success;
+
+  free(self->queue.array);
+  free(self);
+
+  return Success;
+}
+
+task_t HC05AT_Submit(HC05AT_DS *const self, const HC05AT_Command_t *const command)
+{
+  if (command->len == 0 || command->len > HC05AT_MAX_COMMAND)
+    return Fail;
+
+  if (self->queue.tail - self->queue.head >= self->queue.size)
+    return Fail;
+
+  self->queue.array[self->queue.tail % self->queue.size] = *command;
+  self->queue.tail++;
+
+  return Success;
+}
+
+size_t HC05AT_Feed(HC05AT_DS *const self, const uint8_t array[], size_t len)
+{
+  size_t i = 0;
+
+  // ? bytes after the status line are not ours
+  while (i < len && self->isWaiting)
+    _HC05AT_Byte(self, array[i++]);
+
+  return i;
+}
+
+void HC05AT_Poll(HC05AT_DS *const self, uint32_t now)
+{
+  if (self->isWaiting)
+  {
+    // ? the answer may still be cut, a late status line is dropped with the stream
+    if (now - self->sent >= self->current.timeout)
+      _HC05AT_Complete(self, Fail, HC05AT_ERROR_TIMEOUT);
+
+    return;
+  }
+
+  if (self->queue.head == self->queue.tail)
+    return;
+
+  const HC05AT_Command_t *const next = &self->queue.array[self->queue.head % self->queue.size];
+
+  // ? the line end goes with the command, the module never sees half a line
+  uint8_t line[HC05AT_MAX_COMMAND + 2];
+
+  for (size_t i = 0; i < next->len; ++i)
+    line[i] = next->cmd[i];
+
+  line[next->len] = '\r';
+  line[next->len + 1] = '\n';
+
+  // ? TX queue full, try again next poll
+  if (HC05_Send(self->device, line, next->len + 2) != Success)
+    return;
+
+  self->current = *next;
+  self->queue.head++;
+
+  self->reply.result = Fail;
+  self->reply.error = HC05AT_ERROR_NONE;
+  self->reply.len = 0;
+
+  self->column = 0;
+  self->isPayload = False;
+  self->sent = now;
+  self->isWaiting = True;
+}
+
+bool_t HC05AT_isBusy(HC05AT_DS *const self)
+{
+  return (self->isWaiting || self->queue.head != self->queue.tail) ? True : False;
+}
+
+/* ---------------------------------------------------------------- Class Public Functions End */
+
+#endif // STM32F103xx_UNREADY
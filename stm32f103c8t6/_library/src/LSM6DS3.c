@@ -36,6 +36,117 @@ static task_t _LSM6DS3_ShiftByte(LSM6DS3_DS *const self, const uint8_t TxByte, v
   return Success;
 }
 
+/**
+ * @brief remove the bias from a raw word & saturate
+ *
+ * @param word: raw counts
+ * @param bias: raw counts
+ * @return sint16_t: -32768 ~ 32767
+ */
+static inline sint16_t _LSM6DS3_Subtract(const sint32_t word, const sint32_t bias)
+{
+  const sint32_t value = word - bias;
+
+  if (value > 32767)
+    return 32767;
+  if (value < -32768)
+    return -32768;
+
+  return (sint16_t)value;
+}
+
+/**
+ * @brief save one FIFO word into the decoded pattern
+ *
+ * @param self: object pointer
+ * @param sample: pattern to fill
+ * @param slot: word index in the pattern
+ * @param word: raw data
+ */
+static void _LSM6DS3_DecodeWord(LSM6DS3_DS *const self, LSM6DS3_Sample_t *const sample, const uint8_t slot, const sint16_t word)
+{
+  if (self->fifo.hasGyro && slot < 3)
+    sample->gyro[slot] = _LSM6DS3_Subtract(word, self->bias.gyro[slot]);
+  else
+    sample->acce[slot % 3] = _LSM6DS3_Subtract(word, self->bias.acce[slot % 3]);
+}
+
+/**
+ * @brief merge little-endian byte pairs into X, Y, Z words & remove the bias
+ *
+ * @param raw: 6 bytes, low byte first
+ * @param bias: raw counts of X, Y, Z
+ * @param axis: save words
+ */
+static void _LSM6DS3_ToAxis(volatile const uint8_t raw[6], const sint16_t bias[3], sint16_t axis[3])
+{
+  for (size_t i = 0; i < 3; ++i)
+    axis[i] = _LSM6DS3_Subtract((sint16_t)((raw[2 * i + 1] << 8) | raw[2 * i]), bias[i]);
+}
+
+/**
+ * @brief full-scale bits of both sensors
+ *
+ * @param self: object pointer
+ * @return uint16_t: FS_G (CTRL2_G) in the high byte, FS_XL (CTRL1_XL) in the low byte
+ */
+static inline uint16_t _LSM6DS3_Scale(LSM6DS3_DS *const self)
+{
+  return (uint16_t)((_MASK(self->ctrl[1], 0x0E) << 8) | _MASK(self->ctrl[0], 0x0C));
+}
+
+/**
+ * @brief acce raw counts of 1 g at the current full-scale
+ *
+ * @param self: object pointer
+ * @return sint32_t: counts
+ */
+static inline sint32_t _LSM6DS3_OneG(LSM6DS3_DS *const self)
+{
+  // FS_XL: 2 g, 16 g, 4 g, 8 g
+  const sint32_t table[4] = {16384, 2048, 8192, 4096};
+
+  return table[_MASK(self->ctrl[0] >> 2, 0x03)];
+}
+
+/**
+ * @brief read FIFO status & plan a drain of whole patterns
+ *
+ * @param self: object pointer
+ * @param capacity: max patterns to take
+ * @param skip: save words of a broken pattern at the head
+ * @param total: save whole patterns to take
+ * @param timeout: try times
+ * @return task_t: Success / Fail
+ */
+static task_t _LSM6DS3_PlanFIFO(LSM6DS3_DS *const self, const size_t capacity, size_t *const skip, size_t *const total, uint16_t timeout)
+{
+  volatile uint8_t status[4] = {0};
+
+  *skip = *total = 0;
+
+  if (self->fifo.pattern == 0)
+    return Fail;
+
+  // ? FIFO_STATUS1 ~ FIFO_STATUS4: level & the pattern index of the next word
+  if (LSM6DS3_getRegisters(self, FIFO_STATUS1, status, 4, timeout) != Success)
+    return Fail;
+
+  const uint16_t level = (uint16_t)((_MASK(status[1], 0x0F) << 8) | status[0]);
+  const uint16_t index = (uint16_t)((_MASK(status[3], 0x03) << 8) | status[2]);
+
+  // ? drop the tail of a broken pattern, then take whole patterns only
+  *skip = index ? (self->fifo.pattern - index % self->fifo.pattern) : 0;
+  if (level < *skip + self->fifo.pattern)
+    return Success;
+
+  *total = (level - *skip) / self->fifo.pattern;
+  if (*total > capacity)
+    *total = capacity;
+
+  return Success;
+}
+
 /* ---------------------------------------------------------------- Class Private Functions End */
 
 /** Class Public Functions Begin ---------------------------------------------------------------
@@ -55,11 +166,45 @@ LSM6DS3_DS *LSM6DS3_Constructor(SPI_TypeDef *SPIx, const port_t *const CS)
   obj->CS.GPIOx = CS->GPIOx;
   obj->CS.order = CS->order;
 
+  obj->bus = NULL;
+  obj->device.CS = obj->CS;
+  obj->device.mode = SPI_MODE3;
+  obj->device.maxClock = 10000000; // 10 MHz, refer to the datasheet
+
+  obj->fifo.pattern = 0;
+  obj->fifo.hasGyro = False;
+  obj->fifo.skip = 0;
+  obj->fifo.total = 0;
+
+  // ? reset values of CTRL1_XL ~ CTRL10_C, refer to the datasheet
+  const uint8_t ctrl[10] = {0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x38};
+  for (size_t i = 0; i < 10; ++i)
+    obj->ctrl[i] = ctrl[i];
+
+  obj->id = 0x00;
+
+  for (size_t i = 0; i < 3; ++i)
+    obj->bias.gyro[i] = obj->bias.acce[i] = 0;
+
+  for (size_t i = 0; i < 2; ++i)
+  {
+    obj->irq[i].isBound = False;
+    obj->irq[i].isPending = False;
+    obj->irq[i].timestamp = 0;
+  }
+
   return obj;
 }
 
 task_t LSM6DS3_Destructor(LSM6DS3_DS *const self)
 {
+  if (self == NULL)
+    return Success;
+
+  for (size_t i = 0; i < 2; ++i)
+    if (self->irq[i].isBound)
+      _InterfaceEXTI_Unbind(self->irq[i].line.order);
+
   free(self);
 
   return Success;
@@ -67,32 +212,257 @@ task_t LSM6DS3_Destructor(LSM6DS3_DS *const self)
 
 task_t LSM6DS3_DefaultInit(LSM6DS3_DS *const self)
 {
-  uint8_t value = 0x60; // 412Hz only enable Acce.
-  do
+  const LSM6DS3_Config_t config = {
+      .acce = {.odr = ODR_416Hz, .scale = XL_FS_2G, .bandwidth = XL_BW_ODR, .filter = XL_FILTER_OFF, .cutoff = 0, .power = POWER_HIGH_PERFORMANCE},
+      .gyro = {.odr = ODR_OFF, .scale = G_FS_245DPS, .isHPF = False, .cutoff = 0, .power = POWER_HIGH_PERFORMANCE}};
+
+  if (LSM6DS3_CheckID(self, 10, 1000) != Success)
+    return Fail;
+
+  // BDU & IF_INC: coherent output registers & multi-byte burst access
+  self->ctrl[2] |= (_BIT(6) | _BIT(2));
+
+  return LSM6DS3_Configure(self, &config, 1000);
+}
+
+task_t LSM6DS3_CheckID(LSM6DS3_DS *const self, uint8_t retry, uint16_t timeout)
+{
+  volatile uint8_t id = 0x00;
+
+  while (retry--)
   {
-    value = 0x60;
-    LSM6DS3_setRegister(self, CTRL_ACCE, value, 1000);
-    LSM6DS3_getRegister(self, CTRL_ACCE, &value, 1000);
-  } while (value != 0x60);
+    if (LSM6DS3_getRegister(self, WHO_AM_I, &id, timeout) != Success)
+      continue;
+
+    if (id == 0x69 || id == 0x6A)
+    {
+      self->id = id;
+
+      // ? CTRL9_XL & CTRL10_C are laid out differently on LSM6DS3TR-C
+      if (id == 0x6A)
+      {
+        self->ctrl[8] = 0xE0;
+        self->ctrl[9] = 0x00;
+      }
+
+      return Success;
+    }
+  }
+
+  return Fail;
+}
+
+task_t LSM6DS3_Configure(LSM6DS3_DS *const self, const LSM6DS3_Config_t *const config, uint16_t timeout)
+{
+  const LSM6DS3_AcceConfig_t *const acce = &config->acce;
+  const LSM6DS3_GyroConfig_t *const gyro = &config->gyro;
+
+  // ? gyro stops at 1.66 kHz
+  if (acce->odr > ODR_6k66Hz || gyro->odr > ODR_1k66Hz)
+    return Fail;
+
+  if (acce->bandwidth > XL_BW_ODR || acce->filter > XL_FILTER_HPF || acce->cutoff > 3 || gyro->cutoff > 3)
+    return Fail;
+
+  uint8_t ctrl[10] = {0};
+  for (size_t i = 0; i < 10; ++i)
+    ctrl[i] = self->ctrl[i];
+
+  // CTRL1_XL: ODR_XL, FS_XL & BW_XL
+  ctrl[0] = (uint8_t)((acce->odr << 4) | (_MASK(acce->scale, 0x03) << 2) | _MASK(acce->bandwidth, 0x03));
+
+  // CTRL2_G: ODR_G, FS_G & FS_125
+  ctrl[1] = (uint8_t)((gyro->odr << 4) | (_MASK(gyro->scale, 0x07) << 1));
+
+  // CTRL3_C: never burst BOOT & SW_RESET
+  ctrl[2] &= ~(_BIT(7) | _BIT(0));
+
+  // CTRL4_C: XL_BW_SCAL_ODR, BW_XL is used only when it is set
+  ctrl[3] = (uint8_t)(_MASK(ctrl[3], ~_BIT(7)) | ((acce->bandwidth != XL_BW_ODR) ? _BIT(7) : 0));
+
+  // CTRL6_C: XL_HM_MODE
+  ctrl[5] = (uint8_t)(_MASK(ctrl[5], ~_BIT(4)) | ((acce->power == POWER_LOW) ? _BIT(4) : 0));
+
+  // CTRL7_G: G_HM_MODE, HP_G_EN & HPCF_G, keep ROUNDING_STATUS
+  ctrl[6] = (uint8_t)(_MASK(ctrl[6], _BIT(2)) | ((gyro->power == POWER_LOW) ? _BIT(7) : 0) | (gyro->isHPF ? _BIT(6) : 0) | (gyro->cutoff << 4));
+
+  // CTRL8_XL: LPF2_XL_EN, HPCF_XL & HP_SLOPE_XL_EN, keep LOW_PASS_ON_6D
+  ctrl[7] = (uint8_t)(_MASK(ctrl[7], _BIT(0)) | ((acce->filter == XL_FILTER_LPF2) ? _BIT(7) : 0) | (acce->cutoff << 5) | ((acce->filter == XL_FILTER_HPF) ? _BIT(2) : 0));
+
+  // CTRL9_XL & CTRL10_C: X, Y, Z of both sensors (LSM6DS3 only, always on for LSM6DS3TR-C)
+  if (self->id != 0x6A)
+  {
+    ctrl[8] |= (_BIT(5) | _BIT(4) | _BIT(3));
+    ctrl[9] |= (_BIT(5) | _BIT(4) | _BIT(3));
+  }
+
+  if (LSM6DS3_setRegisters(self, CTRL_ACCE, ctrl, 10, timeout) != Success)
+    return Fail;
+
+  for (size_t i = 0; i < 10; ++i)
+    self->ctrl[i] = ctrl[i];
 
   return Success;
 }
 
-void LSM6DS3_HoldDevice(LSM6DS3_DS *const self)
+task_t LSM6DS3_Calibrate(LSM6DS3_DS *const self, const sint8_t gravity[3], uint16_t samples, uint16_t threshold, LSM6DS3_Bias_t *const bias, uint16_t timeout)
+{
+  if (samples == 0)
+    return Fail;
+
+  // ? ODR_XL & ODR_G, both sensors must be on
+  if (!_MASK(self->ctrl[0], 0xF0) || !_MASK(self->ctrl[1], 0xF0))
+    return Fail;
+
+  // ? measure from zero, drop the previous bias first
+  const LSM6DS3_Bias_t zero = {.gyro = {0}, .acce = {0}, .scale = _LSM6DS3_Scale(self)};
+
+  if (LSM6DS3_SetBias(self, &zero, timeout) != Success)
+    return Fail;
+
+  // ? |sum| < 32768 * 65535, no overflow in 32 bits
+  sint32_t sum[6] = {0};
+  sint16_t min[3] = {32767, 32767, 32767};
+  sint16_t max[3] = {-32768, -32768, -32768};
+
+  for (uint16_t n = 0; n < samples; ++n)
+  {
+    volatile uint8_t status = 0;
+    uint16_t wait = timeout;
+
+    // wait for XLDA & GDA: a new sample of both sensors
+    while (_MASK(status, 0x03) != 0x03)
+    {
+      if (!wait)
+        return Fail;
+      wait--;
+
+      if (LSM6DS3_getRegister(self, STATUS_R, &status, timeout) != Success)
+        return Fail;
+    }
+
+    LSM6DS3_Sample_t sample = {0};
+
+    if (LSM6DS3_GetSample(self, &sample, timeout) != Success)
+      return Fail;
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+      sum[i] += sample.gyro[i];
+      sum[3 + i] += sample.acce[i];
+
+      if (sample.gyro[i] < min[i])
+        min[i] = sample.gyro[i];
+      if (sample.gyro[i] > max[i])
+        max[i] = sample.gyro[i];
+    }
+  }
+
+  const sint32_t oneG = _LSM6DS3_OneG(self);
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    if (max[i] - min[i] > threshold)
+      return Fail;
+
+    bias->gyro[i] = (sint16_t)(sum[i] / samples);
+    bias->acce[i] = _LSM6DS3_Subtract(sum[3 + i] / samples, gravity[i] * oneG);
+  }
+
+  bias->scale = _LSM6DS3_Scale(self);
+
+  return LSM6DS3_SetBias(self, bias, timeout);
+}
+
+task_t LSM6DS3_SetBias(LSM6DS3_DS *const self, const LSM6DS3_Bias_t *const bias, uint16_t timeout)
 {
+  if (bias->scale != _LSM6DS3_Scale(self))
+    return Fail;
+
+  const sint32_t oneG = _LSM6DS3_OneG(self);
+  const bool_t hasOffset = (self->id == 0x6A) ? True : False;
+
+  uint8_t offset[3] = {0};
+  sint16_t rest[3] = {0};
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    sint32_t usr = 0;
+
+    // ? 2^-10 g for each LSB, rounded & limited to +-127
+    if (hasOffset)
+    {
+      usr = (bias->acce[i] * 1024 + ((bias->acce[i] < 0) ? -oneG : oneG) / 2) / oneG;
+
+      if (usr > 127)
+        usr = 127;
+      if (usr < -127)
+        usr = -127;
+    }
+
+    offset[i] = (uint8_t)(sint8_t)usr;
+    rest[i] = _LSM6DS3_Subtract(bias->acce[i], (usr * oneG) / 1024);
+  }
+
+  if (hasOffset)
+  {
+    // CTRL6_C: USR_OFF_W = 0, 2^-10 g weight
+    if (_MASK(self->ctrl[5], _BIT(3)))
+    {
+      if (LSM6DS3_setRegister(self, CTRL6_C, self->ctrl[5] & ~_BIT(3), timeout) != Success)
+        return Fail;
+
+      self->ctrl[5] &= ~_BIT(3);
+    }
+
+    // ? the device subtracts the offset from both the output registers & FIFO
+    if (LSM6DS3_setRegisters(self, X_OFS_USR, offset, 3, timeout) != Success)
+      return Fail;
+  }
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    self->bias.gyro[i] = bias->gyro[i];
+    self->bias.acce[i] = rest[i];
+  }
+
+  return Success;
+}
+
+task_t LSM6DS3_AttachBus(LSM6DS3_DS *const self, SPIBus_DS *const bus)
+{
+  if (bus->SPIx != self->SPIx)
+    return Fail;
+
+  self->bus = bus;
+
+  return Success;
+}
+
+task_t LSM6DS3_HoldDevice(LSM6DS3_DS *const self, uint16_t timeout)
+{
+  if (self->bus && SPIBus_Acquire(self->bus, &self->device, timeout) != Success)
+    return Fail;
+
   self->CS.GPIOx->BSRR = _BIT(self->CS.order) << 16;
+
+  return Success;
 }
 
 void LSM6DS3_FreeDevice(LSM6DS3_DS *const self)
 {
   self->CS.GPIOx->BSRR = _BIT(self->CS.order);
+
+  if (self->bus)
+    SPIBus_Release(self->bus);
 }
 
 task_t LSM6DS3_setRegister(LSM6DS3_DS *const self, const uint8_t reg, const uint8_t byte, uint16_t timeout)
 {
   task_t result = Success;
 
-  LSM6DS3_HoldDevice(self);
+  if (LSM6DS3_HoldDevice(self, timeout) != Success)
+    return Fail;
 
   if (_LSM6DS3_ShiftByte(self, reg, 0, timeout) != Success)
     result = Fail;
@@ -104,13 +474,33 @@ task_t LSM6DS3_setRegister(LSM6DS3_DS *const self, const uint8_t reg, const uint
   return result;
 }
 
+task_t LSM6DS3_setRegisters(LSM6DS3_DS *const self, const uint8_t reg, const uint8_t array[], size_t len, uint16_t timeout)
+{
+  task_t result = Success;
+
+  if (LSM6DS3_HoldDevice(self, timeout) != Success)
+    return Fail;
+
+  if (_LSM6DS3_ShiftByte(self, reg, 0, timeout) != Success)
+    result = Fail;
+
+  for (size_t i = 0; result == Success && i < len; ++i)
+    if (_LSM6DS3_ShiftByte(self, array[i], 0, timeout) != Success)
+      result = Fail;
+
+  LSM6DS3_FreeDevice(self);
+
+  return result;
+}
+
 task_t LSM6DS3_getRegister(LSM6DS3_DS *const self, const uint8_t reg, volatile uint8_t *const byte, uint16_t timeout)
 {
   task_t result = Success;
 
   const uint8_t rreg = (reg | 0x80);
 
-  LSM6DS3_HoldDevice(self);
+  if (LSM6DS3_HoldDevice(self, timeout) != Success)
+    return Fail;
 
   if (_LSM6DS3_ShiftByte(self, rreg, 0, timeout) != Success)
     result = Fail;
@@ -121,6 +511,460 @@ task_t LSM6DS3_getRegister(LSM6DS3_DS *const self, const uint8_t reg, volatile u
 
   return result;
 }
+
+task_t LSM6DS3_getRegisters(LSM6DS3_DS *const self, const uint8_t reg, volatile uint8_t array[], size_t len, uint16_t timeout)
+{
+  task_t result = Success;
+
+  const uint8_t rreg = (reg | 0x80);
+
+  if (LSM6DS3_HoldDevice(self, timeout) != Success)
+    return Fail;
+
+  if (_LSM6DS3_ShiftByte(self, rreg, 0, timeout) != Success)
+    result = Fail;
+
+  for (size_t i = 0; result == Success && i < len; ++i)
+    if (_LSM6DS3_ShiftByte(self, 0, &array[i], timeout) != Success)
+      result = Fail;
+
+  LSM6DS3_FreeDevice(self);
+
+  return result;
+}
+
+task_t LSM6DS3_GetSample(LSM6DS3_DS *const self, LSM6DS3_Sample_t *const sample, uint16_t timeout)
+{
+  volatile uint8_t raw[12] = {0};
+
+  // ? GYRO_X_L ~ ACCE_Z_H are adjacent, one window keeps all axes coherent
+  if (LSM6DS3_getRegisters(self, GYRO_X_L, raw, 12, timeout) != Success)
+    return Fail;
+
+  _LSM6DS3_ToAxis(&raw[0], self->bias.gyro, sample->gyro);
+  _LSM6DS3_ToAxis(&raw[6], self->bias.acce, sample->acce);
+
+  return Success;
+}
+
+task_t LSM6DS3_GetAcce(LSM6DS3_DS *const self, sint16_t acce[3], uint16_t timeout)
+{
+  volatile uint8_t raw[6] = {0};
+
+  if (LSM6DS3_getRegisters(self, ACCE_X_L, raw, 6, timeout) != Success)
+    return Fail;
+
+  _LSM6DS3_ToAxis(raw, self->bias.acce, acce);
+
+  return Success;
+}
+
+task_t LSM6DS3_GetGyro(LSM6DS3_DS *const self, sint16_t gyro[3], uint16_t timeout)
+{
+  volatile uint8_t raw[6] = {0};
+
+  if (LSM6DS3_getRegisters(self, GYRO_X_L, raw, 6, timeout) != Success)
+    return Fail;
+
+  _LSM6DS3_ToAxis(raw, self->bias.gyro, gyro);
+
+  return Success;
+}
+
+task_t LSM6DS3_SetFIFO(LSM6DS3_DS *const self, const LSM6DS3_FIFOConfig_t *const config, uint16_t timeout)
+{
+  if (config->gyro != DEC_OFF && config->acce != DEC_OFF && config->gyro != config->acce)
+    return Fail;
+
+  if (config->watermark > 0x0FFF)
+    return Fail;
+
+  // ? switch to bypass mode to flush the previous content
+  if (LSM6DS3_setRegister(self, FIFO_CTRL5, FIFO_BYPASS, timeout) != Success)
+    return Fail;
+
+  const uint8_t table[] = {
+      [0] = (uint8_t)_MASK(config->watermark, 0x00FF),                                 // FIFO_CTRL1: FTH[7:0]
+      [1] = (uint8_t)(_MASK(config->watermark, 0x0F00) >> 8),                          // FIFO_CTRL2: FTH[11:8]
+      [2] = (uint8_t)((_MASK(config->gyro, 0x07) << 3) | _MASK(config->acce, 0x07)),   // FIFO_CTRL3: DEC_FIFO_GYRO & DEC_FIFO_XL
+      [3] = 0x00,                                                                      // FIFO_CTRL4: no 3rd & 4th data set
+      [4] = (uint8_t)((_MASK(config->odr, 0x0F) << 3) | _MASK(config->mode, 0x07))};   // FIFO_CTRL5: ODR_FIFO & FIFO_MODE
+
+  for (size_t i = 0; i < sizeof(table); ++i)
+    if (LSM6DS3_setRegister(self, FIFO_CTRL1 + i, table[i], timeout) != Success)
+      return Fail;
+
+  self->fifo.hasGyro = (config->gyro != DEC_OFF) ? True : False;
+  self->fifo.pattern = (config->gyro != DEC_OFF ? 3 : 0) + (config->acce != DEC_OFF ? 3 : 0);
+
+  return Success;
+}
+
+task_t LSM6DS3_GetFIFOStatus(LSM6DS3_DS *const self, volatile uint16_t *const level, volatile flag8_t *const flags, uint16_t timeout)
+{
+  volatile uint8_t status[2] = {0};
+
+  if (LSM6DS3_getRegisters(self, FIFO_STATUS1, status, 2, timeout) != Success)
+    return Fail;
+
+  *level = (uint16_t)((_MASK(status[1], 0x0F) << 8) | status[0]);
+  *flags = _MASK(status[1], 0xF0);
+
+  return Success;
+}
+
+bool_t LSM6DS3_isFIFOWatermark(LSM6DS3_DS *const self)
+{
+  volatile uint8_t status = 0;
+
+  if (LSM6DS3_getRegister(self, FIFO_STATUS2, &status, 1000) != Success)
+    return False;
+
+  return _MASK(status, _BIT(7)) ? True : False;
+}
+
+task_t LSM6DS3_DrainFIFO(LSM6DS3_DS *const self, LSM6DS3_Sample_t samples[], size_t capacity, volatile size_t *const count, uint16_t timeout)
+{
+  task_t result = Success;
+  volatile uint8_t raw[2] = {0};
+  size_t skip = 0, total = 0;
+
+  *count = 0;
+
+  if (_LSM6DS3_PlanFIFO(self, capacity, &skip, &total, timeout) != Success)
+    return Fail;
+
+  if (total == 0)
+    return Success;
+
+  // ? FIFO_DATA_H rolls back to FIFO_DATA_L, so words can be read in one CS window
+  if (LSM6DS3_HoldDevice(self, timeout) != Success)
+    return Fail;
+
+  if (_LSM6DS3_ShiftByte(self, (FIFO_DATA_L | 0x80), 0, timeout) != Success)
+    result = Fail;
+
+  for (size_t i = 0; result == Success && i < skip; ++i)
+    if (_LSM6DS3_ShiftByte(self, 0, 0, timeout) != Success || _LSM6DS3_ShiftByte(self, 0, 0, timeout) != Success)
+      result = Fail;
+
+  for (size_t n = 0; result == Success && n < total; ++n)
+  {
+    samples[n] = (LSM6DS3_Sample_t){0};
+
+    for (uint8_t slot = 0; slot < self->fifo.pattern; ++slot)
+    {
+      if (_LSM6DS3_ShiftByte(self, 0, &raw[0], timeout) != Success || _LSM6DS3_ShiftByte(self, 0, &raw[1], timeout) != Success)
+      {
+        result = Fail;
+        break;
+      }
+      _LSM6DS3_DecodeWord(self, &samples[n], slot, (sint16_t)((raw[1] << 8) | raw[0]));
+    }
+
+    if (result == Success)
+      *count = n + 1;
+  }
+
+  LSM6DS3_FreeDevice(self);
+
+  return result;
+}
+
+task_t LSM6DS3_DrainFIFOAsync(LSM6DS3_DS *const self, volatile uint8_t raw[], size_t size, SPIDMA_Callback_t callback, void *context)
+{
+  size_t skip = 0, total = 0;
+
+  if (self->bus == NULL)
+    return Fail;
+
+  if (self->fifo.pattern == 0 || size < 2 * (size_t)(self->fifo.pattern + self->fifo.pattern - 1))
+    return Fail;
+
+  // ? the worst case skip is (pattern - 1) words, keep room for it
+  const size_t capacity = (size / 2 - (self->fifo.pattern - 1)) / self->fifo.pattern;
+
+  if (_LSM6DS3_PlanFIFO(self, capacity, &skip, &total, 1000) != Success || total == 0)
+    return Fail;
+
+  self->fifo.skip = skip;
+  self->fifo.total = total;
+
+  const SPIBus_Transaction_t transaction = {
+      .device = &self->device,
+      .header = {(FIFO_DATA_L | 0x80)},
+      .headerLen = 1,
+      .tx = NULL,
+      .rx = raw,
+      .len = 2 * (skip + total * self->fifo.pattern),
+      .callback = callback,
+      .context = context};
+
+  return SPIBus_Submit(self->bus, &transaction);
+}
+
+task_t LSM6DS3_DecodeFIFO(LSM6DS3_DS *const self, volatile const uint8_t raw[], LSM6DS3_Sample_t samples[], size_t capacity, volatile size_t *const count)
+{
+  *count = 0;
+
+  if (self->fifo.pattern == 0)
+    return Fail;
+
+  const size_t total = (self->fifo.total < capacity) ? self->fifo.total : capacity;
+
+  raw += 2 * self->fifo.skip;
+
+  for (size_t n = 0; n < total; ++n)
+  {
+    samples[n] = (LSM6DS3_Sample_t){0};
+
+    for (uint8_t slot = 0; slot < self->fifo.pattern; ++slot, raw += 2)
+      _LSM6DS3_DecodeWord(self, &samples[n], slot, (sint16_t)((raw[1] << 8) | raw[0]));
+  }
+
+  *count = total;
+
+  return Success;
+}
+
+task_t LSM6DS3_SetInterrupt(LSM6DS3_DS *const self, const LSM6DS3_Pin_Enum pin, const flag8_t sources, uint16_t timeout)
+{
+  if (pin != LSM6DS3_INT1 && pin != LSM6DS3_INT2)
+    return Fail;
+
+  return LSM6DS3_setRegister(self, (pin == LSM6DS3_INT1) ? INT1_CTRL : INT2_CTRL, sources, timeout);
+}
+
+task_t LSM6DS3_SetPinMode(LSM6DS3_DS *const self, const bool_t isOpenDrain, const bool_t isActiveLow, uint16_t timeout)
+{
+  // CTRL3_C: H_LACTIVE & PP_OD, never burst BOOT & SW_RESET
+  const uint8_t ctrl = (uint8_t)(_MASK(self->ctrl[2], ~(_BIT(7) | _BIT(5) | _BIT(4) | _BIT(0))) | (isActiveLow ? _BIT(5) : 0) | (isOpenDrain ? _BIT(4) : 0));
+
+  if (LSM6DS3_setRegister(self, CTRL3_C, ctrl, timeout) != Success)
+    return Fail;
+
+  self->ctrl[2] = ctrl;
+
+  return Success;
+}
+
+task_t LSM6DS3_BindInterrupt(LSM6DS3_DS *const self, const LSM6DS3_Pin_Enum pin, const port_t *const line)
+{
+  if (pin != LSM6DS3_INT1 && pin != LSM6DS3_INT2)
+    return Fail;
+
+  if (line->order > 15)
+    return Fail;
+
+  self->irq[pin].line.GPIOx = line->GPIOx;
+  self->irq[pin].line.order = line->order;
+  self->irq[pin].isPending = False;
+
+  // ? active level follows H_LACTIVE of CTRL3_C, set it with LSM6DS3_SetPinMode() first
+  _InterfaceEXTI_Bind(line, _MASK(self->ctrl[2], _BIT(5)) ? EXTI_FALLING : EXTI_RISING);
+  self->irq[pin].isBound = True;
+
+  return Success;
+}
+
+void LSM6DS3_IRQHandler(LSM6DS3_DS *const self, const uint32_t timestamp)
+{
+  for (size_t i = 0; i < 2; ++i)
+  {
+    if (!self->irq[i].isBound || !_InterfaceEXTI_isPending(self->irq[i].line.order))
+      continue;
+
+    _InterfaceEXTI_Clear(self->irq[i].line.order);
+
+    self->irq[i].timestamp = timestamp;
+    self->irq[i].isPending = True;
+  }
+}
+
+bool_t LSM6DS3_TakeInterrupt(LSM6DS3_DS *const self, const LSM6DS3_Pin_Enum pin, volatile uint32_t *const timestamp)
+{
+  if (pin != LSM6DS3_INT1 && pin != LSM6DS3_INT2)
+    return False;
+
+  if (!self->irq[pin].isBound)
+    return False;
+
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  // ? a latched source stays high until it is served, its next edge never comes
+  bool_t isReady = self->irq[pin].isPending;
+  if ((_MASK(self->irq[pin].line.GPIOx->IDR, _BIT(self->irq[pin].line.order)) ? True : False) != (_MASK(self->ctrl[2], _BIT(5)) ? True : False))
+    isReady = True;
+
+  self->irq[pin].isPending = False;
+
+  if (isReady && timestamp)
+    *timestamp = self->irq[pin].timestamp;
+
+  __set_PRIMASK(primask);
+
+  return isReady;
+}
+
+task_t LSM6DS3_GetReadySample(LSM6DS3_DS *const self, const LSM6DS3_Pin_Enum pin, LSM6DS3_Sample_t *const sample, volatile uint32_t *const timestamp, uint16_t timeout)
+{
+  if (!LSM6DS3_TakeInterrupt(self, pin, timestamp))
+    return Fail;
+
+  // ? reading the output registers releases the latched DRDY
+  return LSM6DS3_GetSample(self, sample, timeout);
+}
+
+task_t LSM6DS3_SetMotion(LSM6DS3_DS *const self, const LSM6DS3_MotionConfig_t *const config, uint16_t timeout)
+{
+  if (config->wakeUp.threshold > 63 || config->wakeUp.duration > 3 || config->freeFall.threshold > 7 || config->freeFall.duration > 63)
+    return Fail;
+
+  if (config->tap.axes > 0x07 || config->tap.threshold > 31 || config->tap.shock > 3 || config->tap.quiet > 3 || config->tap.gap > 15)
+    return Fail;
+
+  volatile uint8_t table[6] = {0};
+
+  // ? TAP_CFG ~ FREE_FALL, keep bits of other functions
+  if (LSM6DS3_getRegisters(self, TAP_CFG, table, 6, timeout) != Success)
+    return Fail;
+
+  // TAP_CFG: INTERRUPTS_ENABLE (LSM6DS3TR-C, TIMER_EN is kept on LSM6DS3), TAP_X/Y/Z_EN & LIR, slope filter
+  table[0] = (uint8_t)(_MASK(table[0], 0xE0) | (config->tap.axes << 1) | (config->isLatched ? _BIT(0) : 0));
+  if (self->id == 0x6A)
+    table[0] |= _BIT(7);
+
+  // TAP_THS_6D: TAP_THS, keep D4D_EN & SIXD_THS
+  table[1] = (uint8_t)(_MASK(table[1], 0xE0) | config->tap.threshold);
+
+  // INT_DUR2: DUR, QUIET & SHOCK
+  table[2] = (uint8_t)((config->tap.gap << 4) | (config->tap.quiet << 2) | config->tap.shock);
+
+  // WAKE_UP_THS: SINGLE_DOUBLE_TAP & WK_THS, keep INACTIVITY
+  table[3] = (uint8_t)(_MASK(table[3], _BIT(6)) | (config->tap.isDouble ? _BIT(7) : 0) | config->wakeUp.threshold);
+
+  // WAKE_UP_DUR: FF_DUR5 & WAKE_DUR, keep TIMER_HR & SLEEP_DUR
+  table[4] = (uint8_t)(_MASK(table[4], 0x1F) | (_MASK(config->freeFall.duration, 0x20) << 2) | (config->wakeUp.duration << 5));
+
+  // FREE_FALL: FF_DUR[4:0] & FF_THS
+  table[5] = (uint8_t)((_MASK(config->freeFall.duration, 0x1F) << 3) | config->freeFall.threshold);
+
+  const uint8_t bytes[6] = {table[0], table[1], table[2], table[3], table[4], table[5]};
+
+  if (LSM6DS3_setRegisters(self, TAP_CFG, bytes, 6, timeout) != Success)
+    return Fail;
+
+  // CTRL10_C: FUNC_EN & SIGN_MOTION_EN
+  uint8_t ctrl = self->ctrl[9];
+
+  if (config->isSignificantMotion)
+    ctrl |= (_BIT(2) | _BIT(0));
+  else
+    ctrl &= ~_BIT(0);
+
+  if (ctrl != self->ctrl[9])
+  {
+    if (LSM6DS3_setRegister(self, CTRL10_C, ctrl, timeout) != Success)
+      return Fail;
+
+    self->ctrl[9] = ctrl;
+  }
+
+  return Success;
+}
+
+task_t LSM6DS3_RouteMotion(LSM6DS3_DS *const self, const LSM6DS3_Pin_Enum pin, const flag8_t events, uint16_t timeout)
+{
+  if (pin != LSM6DS3_INT1 && pin != LSM6DS3_INT2)
+    return Fail;
+
+  // ? INTx_TILT & INTx_TIMER are not motion events here
+  const uint8_t md = (uint8_t)_MASK(events, 0xFC);
+
+  return LSM6DS3_setRegister(self, (pin == LSM6DS3_INT1) ? MD1_CFG : MD2_CFG, md, timeout);
+}
+
+task_t LSM6DS3_GetMotion(LSM6DS3_DS *const self, volatile flag8_t *const events, uint16_t timeout)
+{
+  volatile uint8_t source[3] = {0};
+  volatile uint8_t func = 0;
+
+  *events = 0;
+
+  // ? WAKE_UP_SRC, TAP_SRC & D6D_SRC, reading them releases the latch
+  if (LSM6DS3_getRegisters(self, WAKE_UP_SRC, source, 3, timeout) != Success)
+    return Fail;
+
+  if (LSM6DS3_getRegister(self, FUNC_SRC, &func, timeout) != Success)
+    return Fail;
+
+  flag8_t result = 0;
+
+  if (_MASK(source[0], _BIT(5))) // FF_IA
+    result |= EVENT_FREE_FALL;
+  if (_MASK(source[0], _BIT(4))) // SLEEP_STATE_IA
+    result |= EVENT_INACTIVITY;
+  if (_MASK(source[0], _BIT(3))) // WU_IA
+    result |= EVENT_WAKE_UP;
+  if (_MASK(source[1], _BIT(5))) // SINGLE_TAP
+    result |= EVENT_SINGLE_TAP;
+  if (_MASK(source[1], _BIT(4))) // DOUBLE_TAP
+    result |= EVENT_DOUBLE_TAP;
+  if (_MASK(source[2], _BIT(6))) // D6D_IA
+    result |= EVENT_6D;
+  if (_MASK(func, _BIT(6))) // SIGN_MOTION_IA
+    result |= EVENT_SIGN_MOTION;
+
+  *events = result;
+
+  return Success;
+}
+
+task_t LSM6DS3_EnableTimestamp(LSM6DS3_DS *const self, uint16_t timeout)
+{
+  volatile uint8_t byte = 0;
+
+  // WAKE_UP_DUR: TIMER_HR, 25 us per tick
+  if (LSM6DS3_getRegister(self, WAKE_UP_DUR, &byte, timeout) != Success)
+    return Fail;
+  if (LSM6DS3_setRegister(self, WAKE_UP_DUR, (uint8_t)(byte | _BIT(4)), timeout) != Success)
+    return Fail;
+
+  if (self->id == 0x6A)
+  {
+    // CTRL10_C: TIMER_EN (LSM6DS3TR-C)
+    if (LSM6DS3_setRegister(self, CTRL10_C, (uint8_t)(self->ctrl[9] | _BIT(5)), timeout) != Success)
+      return Fail;
+
+    self->ctrl[9] |= _BIT(5);
+  }
+  else
+  {
+    // TAP_CFG: TIMER_EN (LSM6DS3)
+    if (LSM6DS3_getRegister(self, TAP_CFG, &byte, timeout) != Success)
+      return Fail;
+    if (LSM6DS3_setRegister(self, TAP_CFG, (uint8_t)(byte | _BIT(7)), timeout) != Success)
+      return Fail;
+  }
+
+  // ? writing 0xAA into TIMESTAMP2_REG resets the counter
+  return LSM6DS3_setRegister(self, TIMESTAMP2_REG, 0xAA, timeout);
+}
+
+task_t LSM6DS3_GetTimestamp(LSM6DS3_DS *const self, volatile uint32_t *const ticks, uint16_t timeout)
+{
+  volatile uint8_t table[3] = {0};
+
+  // ? one burst, the counter must not carry between the bytes
+  if (LSM6DS3_getRegisters(self, TIMESTAMP0_REG, table, 3, timeout) != Success)
+    return Fail;
+
+  *ticks = ((uint32_t)table[2] << 16) | ((uint32_t)table[1] << 8) | table[0];
+
+  return Success;
+}
+
 /* ---------------------------------------------------------------- Class Public Functions End */
 
 #endif // STM32F103xx_UNREADY
@@ -0,0 +1,135 @@
+#include "RangeGate.h"
+#include <stdlib.h>
+
+#ifndef STM32F103xx_UNREADY
+
+/** Class Public Functions Begin ---------------------------------------------------------------
+ * @brief
+ *
+ */
+
+RangeGate_DS *RangeGate_Constructor(const RangeGate_Config_t *const config, uint32_t now)
+{
+  if (config->window == 0)
+    return NULL;
+
+  RangeGate_DS *obj = (RangeGate_DS *)calloc(1, sizeof(RangeGate_DS));
+
+  if (obj == NULL)
+    return NULL;
+
+  obj->history.array = (uint16_t *)calloc(config->window, sizeof(uint16_t));
+
+  if (obj->history.array == NULL)
+  {
+    free(obj);
+    return NULL;
+  }
+
+  obj->history.size = config->window;
+  obj->stillTime = config->stillTime;
+  obj->band = config->band;
+  obj->variance = config->variance;
+
+  RangeGate_Motion(obj, now);
+
+  return obj;
+}
+
+task_t RangeGate_Destructor(RangeGate_DS *const self)
+{
+  if (self == NULL)
+    return Success;
+
+  free(self->history.array);
+  free(self);
+
+  return Success;
+}
+
+void RangeGate_Motion(RangeGate_DS *const self, uint32_t now)
+{
+  self->lastMotion = now;
+
+  // ? distances before the motion say nothing about the new scene
+  self->history.index = self->history.count = 0;
+
+  self->isActive = True;
+}
+
+bool_t RangeGate_Inertial(RangeGate_DS *const self, uint32_t now, const sint16_t gyro[], size_t stride, size_t len)
+{
+  if (len < 2 || len > 0xFFFF)
+    return False;
+
+  for (size_t axis = 0; axis < 3; ++axis)
+  {
+    sint64_t sum = 0;
+    uint64_t square = 0;
+
+    for (size_t n = 0; n < len; ++n)
+    {
+      const sint32_t x = gyro[n * stride + axis];
+
+      sum += x;
+      square += (uint32_t)(x * x);
+    }
+
+    // var * len ^ 2 = len * sum(x ^ 2) - sum(x) ^ 2, no division in the loop
+    const uint64_t spread = len * square - (uint64_t)(sum * sum);
+
+    if (spread > (uint64_t)self->variance * len * len)
+    {
+      RangeGate_Motion(self, now);
+      return True;
+    }
+  }
+
+  return False;
+}
+
+void RangeGate_Distance(RangeGate_DS *const self, uint16_t distance)
+{
+  self->history.array[self->history.index] = distance;
+  self->history.index = (self->history.index + 1 == self->history.size) ? 0 : self->history.index + 1;
+
+  if (self->history.count < self->history.size)
+    self->history.count++;
+}
+
+bool_t RangeGate_Update(RangeGate_DS *const self, uint32_t now)
+{
+  if (!self->isActive)
+    return False;
+
+  if (now - self->lastMotion < self->stillTime)
+    return True;
+
+  if (self->history.count < self->history.size)
+    return True;
+
+  uint16_t min = 0xFFFF, max = 0;
+
+  for (size_t i = 0; i < self->history.size; ++i)
+  {
+    if (self->history.array[i] < min)
+      min = self->history.array[i];
+    if (self->history.array[i] > max)
+      max = self->history.array[i];
+  }
+
+  // ? still & stable: the next reading would tell nothing new
+  if (max - min <= self->band)
+    self->isActive = False;
+
+  return self->isActive;
+}
+
+bool_t RangeGate_isActive(RangeGate_DS *const self)
+{
+  return self->isActive;
+}
+
+/* ---------------------------------------------------------------- Class Public Functions End */
+
+#endif // STM32F103xx_UNREADY
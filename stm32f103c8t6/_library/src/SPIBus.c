@@ -0,0 +1,236 @@
+#include "SPIBus.h"
+#include <stdlib.h>
+
+#ifndef STM32F103xx_UNREADY
+
+/** Class Private Functions Begin ---------------------------------------------------------------
+ * @brief
+ *
+ */
+
+/**
+ * @brief rewrite CPOL, CPHA & BR only when they differ from the current ones
+ *
+ * @param self: object pointer
+ * @param device: device to talk to
+ */
+static void _SPIBus_Apply(SPIBus_DS *const self, const SPIBus_Device_t *const device)
+{
+  const flag16_t config = (flag16_t)(_MASK(device->mode, 0x03) | (SPIBus_Prescaler(self, device->maxClock) << 3));
+
+  if (config == self->config)
+    return;
+
+  // ? wait for the last frame, SPE must be low while the clock is changed
+  while (_MASK(self->SPIx->SR, _BIT(7)))
+  {
+  }
+
+  const flag32_t enable = _MASK(self->SPIx->CR1, _BIT(6));
+
+  self->SPIx->CR1 &= ~_BIT(6);
+  self->SPIx->CR1 = (self->SPIx->CR1 & ~0x3BU) | config;
+  self->SPIx->CR1 |= enable;
+
+  self->config = config;
+}
+
+static void _SPIBus_Done(task_t result, void *context);
+
+/**
+ * @brief start the head of the queue if the bus is free
+ * @warning call it with interrupts masked
+ *
+ * @param self: object pointer
+ */
+static void _SPIBus_Next(SPIBus_DS *const self)
+{
+  while (!self->isLocked && !SPIDMA_isBusy(self->dma) && self->queue.head != self->queue.tail)
+  {
+    self->current = self->queue.array[self->queue.head % self->queue.size];
+    self->queue.head++;
+
+    _SPIBus_Apply(self, self->current.device);
+
+    SPIDMA_Transfer_t transfer = {
+        .CS = self->current.device->CS,
+        .headerLen = self->current.headerLen,
+        .tx = self->current.tx,
+        .rx = self->current.rx,
+        .len = self->current.len,
+        .callback = _SPIBus_Done,
+        .context = self};
+
+    for (uint8_t i = 0; i < self->current.headerLen; ++i)
+      transfer.header[i] = self->current.header[i];
+
+    if (SPIDMA_Start(self->dma, &transfer) == Success)
+      return;
+
+    if (self->current.callback)
+      self->current.callback(Fail, self->current.context);
+  }
+}
+
+/**
+ * @brief DMA completion: chain the next transaction, then notify the owner
+ *
+ * @param result: Success / Fail
+ * @param context: object pointer
+ */
+static void _SPIBus_Done(task_t result, void *context)
+{
+  SPIBus_DS *const self = (SPIBus_DS *)context;
+
+  const SPIDMA_Callback_t callback = self->current.callback;
+  void *const owner = self->current.context;
+
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  _SPIBus_Next(self);
+  __set_PRIMASK(primask);
+
+  if (callback)
+    callback(result, owner);
+}
+
+/* ---------------------------------------------------------------- Class Private Functions End */
+
+/** Class Public Functions Begin ---------------------------------------------------------------
+ * @brief
+ *
+ */
+
+SPIBus_DS *SPIBus_Constructor(SPI_TypeDef *SPIx, size_t depth)
+{
+  if (depth == 0)
+    return NULL;
+
+  SPIBus_DS *obj = (SPIBus_DS *)calloc(1, sizeof(SPIBus_DS));
+
+  if (obj == NULL)
+    return NULL;
+
+  obj->dma = SPIDMA_Constructor(SPIx);
+  obj->queue.array = (SPIBus_Transaction_t *)calloc(depth, sizeof(SPIBus_Transaction_t));
+
+  if (obj->dma == NULL || obj->queue.array == NULL)
+  {
+    SPIDMA_Destructor(obj->dma);
+    free(obj->queue.array);
+    free(obj);
+    return NULL;
+  }
+
+  obj->SPIx = SPIx;
+  obj->queue.head = obj->queue.tail = 0;
+  obj->queue.size = depth;
+  obj->config = (flag16_t)_MASK(SPIx->CR1, 0x3B);
+  obj->isLocked = False;
+
+  return obj;
+}
+
+task_t SPIBus_Destructor(SPIBus_DS *const self)
+{
+  if (self == NULL)
+    return Success;
+
+  SPIDMA_Destructor(self->dma);
+  free(self->queue.array);
+  free(self);
+
+  return Success;
+}
+
+task_t SPIBus_Submit(SPIBus_DS *const self, const SPIBus_Transaction_t *const transaction)
+{
+  if (transaction->device == NULL || transaction->len == 0 || transaction->len > 0xFFFF)
+    return Fail;
+
+  if (transaction->headerLen > sizeof(transaction->header))
+    return Fail;
+
+  task_t result = Fail;
+
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  if (self->queue.tail - self->queue.head < self->queue.size)
+  {
+    self->queue.array[self->queue.tail % self->queue.size] = *transaction;
+    self->queue.tail++;
+    _SPIBus_Next(self);
+    result = Success;
+  }
+
+  __set_PRIMASK(primask);
+
+  return result;
+}
+
+task_t SPIBus_Acquire(SPIBus_DS *const self, const SPIBus_Device_t *const device, uint32_t timeout)
+{
+  do
+  {
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    // ? queued transactions go first, so interrupts are never starved
+    if (!self->isLocked && !SPIDMA_isBusy(self->dma) && self->queue.head == self->queue.tail)
+    {
+      self->isLocked = True;
+      __set_PRIMASK(primask);
+
+      _SPIBus_Apply(self, device);
+      return Success;
+    }
+
+    __set_PRIMASK(primask);
+  } while (timeout--);
+
+  return Fail;
+}
+
+void SPIBus_Release(SPIBus_DS *const self)
+{
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  self->isLocked = False;
+  _SPIBus_Next(self);
+
+  __set_PRIMASK(primask);
+}
+
+uint8_t SPIBus_Prescaler(SPIBus_DS *const self, uint32_t maxClock)
+{
+  const uint32_t pclk = _APBClock(self->SPIx == SPI1 ? True : False);
+
+  if (maxClock > SPIBUS_MAX_CLOCK)
+    maxClock = SPIBUS_MAX_CLOCK;
+
+  // ? the slowest one (fPCLK / 256) is taken if nothing is legal
+  uint8_t br = 0;
+  while (br < 0x07 && (pclk >> (br + 1)) > maxClock)
+    br++;
+
+  return br;
+}
+
+bool_t SPIBus_isIdle(SPIBus_DS *const self)
+{
+  if (self->isLocked || SPIDMA_isBusy(self->dma))
+    return False;
+
+  return (self->queue.head == self->queue.tail) ? True : False;
+}
+
+void SPIBus_IRQHandler(SPIBus_DS *const self)
+{
+  SPIDMA_IRQHandler(self->dma);
+}
+
+/* ---------------------------------------------------------------- Class Public Functions End */
+
+#endif // STM32F103xx_UNREADY
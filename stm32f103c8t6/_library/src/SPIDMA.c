@@ -0,0 +1,156 @@
+#include "SPIDMA.h"
+#include <stdlib.h>
+
+#ifndef STM32F103xx_UNREADY
+
+/** Class Private Functions Begin ---------------------------------------------------------------
+ * @brief
+ *
+ */
+
+/**
+ * @brief stop both channels & release SPIx DMA requests
+ *
+ * @param self: object pointer
+ */
+static void _SPIDMA_Stop(SPIDMA_DS *const self)
+{
+  _InterfaceDMA_Disable(self->tx.channel);
+  _InterfaceDMA_Disable(self->rx.channel);
+
+  _InterfaceDMA_Clear(self->DMAx, self->tx.order, DMA_GIF);
+  _InterfaceDMA_Clear(self->DMAx, self->rx.order, DMA_GIF);
+
+  self->SPIx->CR2 &= ~(_BIT(1) | _BIT(0)); // disable TXDMAEN & RXDMAEN
+}
+
+/* ---------------------------------------------------------------- Class Private Functions End */
+
+/** Class Public Functions Begin ---------------------------------------------------------------
+ * @brief
+ *
+ */
+
+SPIDMA_DS *SPIDMA_Constructor(SPI_TypeDef *SPIx)
+{
+  if (SPIx != SPI1 && SPIx != SPI2)
+    return NULL;
+
+  SPIDMA_DS *obj = (SPIDMA_DS *)calloc(1, sizeof(SPIDMA_DS));
+
+  if (obj == NULL)
+    return NULL;
+
+  obj->SPIx = SPIx;
+  obj->DMAx = DMA1;
+
+  if (SPIx == SPI1)
+  {
+    obj->rx.channel = DMA1_Channel2;
+    obj->rx.order = 2;
+    obj->tx.channel = DMA1_Channel3;
+    obj->tx.order = 3;
+  }
+  else
+  {
+    obj->rx.channel = DMA1_Channel4;
+    obj->rx.order = 4;
+    obj->tx.channel = DMA1_Channel5;
+    obj->tx.order = 5;
+  }
+
+  obj->isBusy = False;
+  obj->dummy = 0x00;
+
+  return obj;
+}
+
+task_t SPIDMA_Destructor(SPIDMA_DS *const self)
+{
+  free(self);
+
+  return Success;
+}
+
+bool_t SPIDMA_isBusy(SPIDMA_DS *const self)
+{
+  return self->isBusy;
+}
+
+task_t SPIDMA_Start(SPIDMA_DS *const self, const SPIDMA_Transfer_t *const transfer)
+{
+  if (self->isBusy)
+    return Fail;
+
+  if (transfer->headerLen > sizeof(transfer->header))
+    return Fail;
+
+  self->isBusy = True;
+  self->current = *transfer;
+
+  const SPIDMA_Transfer_t *const curr = &self->current;
+
+  // ? rx has the higher priority, so DR is always read before the next byte lands
+  const flag32_t rxConfig = DMA_TCIE | DMA_TEIE | DMA_PRIO_VERY_HIGH | (curr->rx ? DMA_MINC : 0);
+  const flag32_t txConfig = DMA_TEIE | DMA_MEM2PER | DMA_PRIO_HIGH | (curr->tx ? DMA_MINC : 0);
+
+  if (
+      _InterfaceDMA_Config(self->rx.channel, &self->SPIx->DR, curr->rx ? (volatile void *)curr->rx : &self->sink, curr->len, rxConfig) != Success ||
+      _InterfaceDMA_Config(self->tx.channel, &self->SPIx->DR, curr->tx ? (const void *)curr->tx : &self->dummy, curr->len, txConfig) != Success)
+  {
+    self->isBusy = False;
+    return Fail;
+  }
+
+  // CS low
+  curr->CS.GPIOx->BSRR = _BIT(curr->CS.order) << 16;
+
+  for (uint8_t i = 0; i < curr->headerLen; ++i)
+    _InterfaceSPI_ShiftByte(self->SPIx, curr->header[i], 0);
+
+  _InterfaceDMA_Clear(self->DMAx, self->rx.order, DMA_GIF);
+  _InterfaceDMA_Clear(self->DMAx, self->tx.order, DMA_GIF);
+
+  // ? refer to the reference manual: RXDMAEN -> channels -> TXDMAEN
+  self->SPIx->CR2 |= _BIT(0);
+  _InterfaceDMA_Enable(self->rx.channel);
+  _InterfaceDMA_Enable(self->tx.channel);
+  self->SPIx->CR2 |= _BIT(1);
+
+  return Success;
+}
+
+void SPIDMA_IRQHandler(SPIDMA_DS *const self)
+{
+  task_t result = Success;
+
+  if (
+      _InterfaceDMA_isFlag(self->DMAx, self->rx.order, DMA_TEIF) ||
+      _InterfaceDMA_isFlag(self->DMAx, self->tx.order, DMA_TEIF))
+    result = Fail;
+  else if (!_InterfaceDMA_isFlag(self->DMAx, self->rx.order, DMA_TCIF))
+    return;
+
+  _SPIDMA_Stop(self);
+
+  // ? the last byte is received, wait for SCK to go idle before CS high
+  while (_MASK(self->SPIx->SR, _BIT(7)))
+  {
+  }
+
+  // CS high
+  self->current.CS.GPIOx->BSRR = _BIT(self->current.CS.order);
+
+  const SPIDMA_Callback_t callback = self->current.callback;
+  void *const context = self->current.context;
+
+  // ? release before notifying, so the callback may start the next transfer
+  self->isBusy = False;
+
+  if (callback)
+    callback(result, context);
+}
+
+/* ---------------------------------------------------------------- Class Public Functions End */
+
+#endif // STM32F103xx_UNREADY
@@ -8,6 +8,24 @@
  *
  */
 
+/**
+ * @brief find the entry of a port, or add it
+ *
+ * @param self: object pointer
+ * @param GPIOx: port of a pin
+ * @return SevenSegment_Port_t*: entry of the port
+ */
+static SevenSegment_Port_t *_SevenSegment_Port(SevenSegment_DS *const self, GPIO_TypeDef *GPIOx)
+{
+  for (size_t i = 0; i < self->count; ++i)
+    if (self->port[i].GPIOx == GPIOx)
+      return &self->port[i];
+
+  self->port[self->count].GPIOx = GPIOx;
+
+  return &self->port[self->count++];
+}
+
 /* ---------------------------------------------------------------- Class Private Functions End */
 
 /** Class Public Functions Begin ---------------------------------------------------------------
@@ -22,13 +40,55 @@ SevenSegment_DS *SevenSegment_Constructor(const port_t *const common, const port
   if (obj == NULL)
     return NULL;
 
+  // ? one entry per distinct port, e.g. one for segments all on GPIOB
+  size_t ports = 0;
+
+  for (size_t i = 0; i < 8; ++i)
+  {
+    size_t j = 0;
+
+    while (j < i && io[j].GPIOx != io[i].GPIOx)
+      j++;
+
+    if (j == i)
+      ports++;
+  }
+
+  obj->port = (SevenSegment_Port_t *)calloc(ports, sizeof(SevenSegment_Port_t));
+
+  if (obj->port == NULL)
+  {
+    free(obj);
+    return NULL;
+  }
+
   obj->common.GPIOx = common->GPIOx;
   obj->common.order = common->order;
+  obj->count = 0;
 
+  // ? open drain, active low: a lit segment is reset, a dark one is set
   for (size_t i = 0; i < 8; ++i)
   {
-    obj->io[i].GPIOx = io[i].GPIOx;
-    obj->io[i].order = io[i].order;
+    SevenSegment_Port_t *const port = _SevenSegment_Port(obj, io[i].GPIOx);
+    uint32_t *const table = (i < 4) ? port->low : port->high;
+    const uint8_t bit = (uint8_t)_BIT(i % 4);
+
+    for (size_t nibble = 0; nibble < 16; ++nibble)
+      table[nibble] |= _MASK(nibble, bit) ? _BIT(io[i].order) << 16 : _BIT(io[i].order);
+  }
+
+  // ? the common goes on in the same write as the segments of its port
+  obj->isApart = True;
+
+  for (size_t i = 0; i < obj->count; ++i)
+  {
+    if (obj->port[i].GPIOx != common->GPIOx)
+      continue;
+
+    for (size_t nibble = 0; nibble < 16; ++nibble)
+      obj->port[i].low[nibble] |= _BIT(common->order) << 16;
+
+    obj->isApart = False;
   }
 
   return obj;
@@ -36,16 +96,18 @@ SevenSegment_DS *SevenSegment_Constructor(const port_t *const common, const port
 
 task_t SevenSegment_Destructor(SevenSegment_DS *const self)
 {
+  free(self->port);
   free(self);
   return Success;
 }
 
 task_t SevenSegment_Set(SevenSegment_DS *const self, flag8_t segment)
 {
-  for (size_t i = 0; i < 8; ++i)
-    self->io[i].GPIOx->BSRR = _MASK(segment, _BIT(i)) ? _BIT(self->io[i].order) << 16 : _BIT(self->io[i].order);
+  for (size_t i = 0; i < self->count; ++i)
+    self->port[i].GPIOx->BSRR = self->port[i].low[segment & 0x0F] | self->port[i].high[segment >> 4];
 
-  self->common.GPIOx->BSRR = _BIT(self->common.order) << 16;
+  if (self->isApart)
+    self->common.GPIOx->BSRR = _BIT(self->common.order) << 16;
 
   return Success;
 }
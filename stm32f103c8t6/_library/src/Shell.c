@@ -0,0 +1,297 @@
+#include "Shell.h"
+#include <stdlib.h>
+
+#ifndef STM32F103xx_UNREADY
+
+/** Class Private Functions Begin ---------------------------------------------------------------
+ * @brief
+ *
+ */
+
+/**
+ * @brief length of a terminated string
+ *
+ * @param str: terminated string
+ * @return size_t: length
+ */
+static size_t _Shell_Length(const char *str)
+{
+  size_t len = 0;
+
+  while (str[len])
+    len++;
+
+  return len;
+}
+
+/**
+ * @brief split a line into tokens pointing into it, no copy
+ *
+ * @param line: words split by spaces or tabs
+ * @param len: length of line
+ * @param tokens: save SHELL_MAX_TOKENS at most
+ * @return size_t: tokens saved, SHELL_MAX_TOKENS + 1 -> too many
+ */
+static size_t _Shell_Split(const uint8_t line[], size_t len, Shell_Token_t tokens[])
+{
+  size_t count = 0;
+
+  for (size_t i = 0; i < len;)
+  {
+    if (line[i] == ' ' || line[i] == '\t')
+    {
+      i++;
+      continue;
+    }
+
+    if (count == SHELL_MAX_TOKENS)
+      return SHELL_MAX_TOKENS + 1;
+
+    tokens[count].str = &line[i];
+
+    while (i < len && line[i] != ' ' && line[i] != '\t')
+      i++;
+
+    tokens[count].len = (size_t)(&line[i] - tokens[count].str);
+    count++;
+  }
+
+  return count;
+}
+
+/**
+ * @brief match the words of a command name against the first tokens
+ *
+ * @param name: words split by one space
+ * @param tokens: from the line
+ * @param count: length of tokens
+ * @return size_t: tokens taken by the name, 0 -> no match
+ */
+static size_t _Shell_Match(const char *name, const Shell_Token_t tokens[], size_t count)
+{
+  size_t matched = 0;
+
+  while (*name)
+  {
+    if (matched == count)
+      return 0;
+
+    const Shell_Token_t *const token = &tokens[matched];
+
+    size_t i = 0;
+    while (name[i] && name[i] != ' ')
+    {
+      if (i == token->len || token->str[i] != (uint8_t)name[i])
+        return 0;
+      i++;
+    }
+
+    if (i != token->len)
+      return 0;
+
+    matched++;
+    name += (name[i] == ' ') ? i + 1 : i;
+  }
+
+  return matched;
+}
+
+/**
+ * @brief print a terminated string
+ *
+ * @param self: object pointer
+ * @param str: terminated string
+ */
+static void _Shell_Text(Shell_DS *const self, const char *str)
+{
+  Shell_Print(self, (const uint8_t *)str, _Shell_Length(str));
+}
+
+/**
+ * @brief print name & usage of a command
+ *
+ * @param self: object pointer
+ * @param command: entry of the table
+ */
+static void _Shell_Usage(Shell_DS *const self, const Shell_Command_t *const command)
+{
+  _Shell_Text(self, command->name);
+
+  if (command->usage && command->usage[0])
+  {
+    _Shell_Text(self, " ");
+    _Shell_Text(self, command->usage);
+  }
+
+  _Shell_Text(self, "\r\n");
+}
+
+/* ---------------------------------------------------------------- Class Private Functions End */
+
+/** Class Public Functions Begin ---------------------------------------------------------------
+ * @brief
+ *
+ */
+
+Shell_DS *Shell_Constructor(const Shell_Command_t table[], size_t count, Shell_Print_t print, void *context)
+{
+  if (table == NULL || count == 0)
+    return NULL;
+
+  Shell_DS *obj = (Shell_DS *)calloc(1, sizeof(Shell_DS));
+
+  if (obj == NULL)
+    return NULL;
+
+  obj->table = table;
+  obj->count = count;
+  obj->print = print;
+  obj->context = context;
+  obj->len = 0;
+  obj->isOverflow = False;
+
+  return obj;
+}
+
+task_t Shell_Destructor(Shell_DS *const self)
+{
+  free(self);
+
+  return Success;
+}
+
+task_t Shell_Feed(Shell_DS *const self, const uint8_t array[], size_t len)
+{
+  task_t status = Success;
+
+  for (size_t i = 0; i < len; ++i)
+  {
+    const uint8_t byte = array[i];
+
+    if (byte != '\r' && byte != '\n')
+    {
+      if (self->len < SHELL_MAX_LINE)
+        self->line[self->len++] = byte;
+      else
+        self->isOverflow = True;
+
+      continue;
+    }
+
+    // ? "\r\n" ends one line, the empty one after it is skipped
+    if (self->isOverflow)
+    {
+      _Shell_Text(self, "line too long\r\n");
+      status = Fail;
+    }
+    else if (self->len != 0 && Shell_Execute(self, self->line, self->len) != Success)
+    {
+      status = Fail;
+    }
+
+    self->len = 0;
+    self->isOverflow = False;
+  }
+
+  return status;
+}
+
+task_t Shell_Execute(Shell_DS *const self, const uint8_t line[], size_t len)
+{
+  Shell_Token_t tokens[SHELL_MAX_TOKENS];
+  const size_t count = _Shell_Split(line, len, tokens);
+
+  if (count == 0)
+    return Success;
+
+  if (count > SHELL_MAX_TOKENS)
+  {
+    _Shell_Text(self, "too many words\r\n");
+    return Fail;
+  }
+
+  if (count == 1 && Shell_isWord(&tokens[0], "help"))
+  {
+    for (size_t i = 0; i < self->count; ++i)
+      _Shell_Usage(self, &self->table[i]);
+
+    return Success;
+  }
+
+  for (size_t i = 0; i < self->count; ++i)
+  {
+    const Shell_Command_t *const command = &self->table[i];
+    const size_t words = _Shell_Match(command->name, tokens, count);
+
+    if (words == 0)
+      continue;
+
+    const size_t argc = count - words;
+
+    if (argc < command->minArgs || argc > command->maxArgs)
+    {
+      _Shell_Text(self, "usage: ");
+      _Shell_Usage(self, command);
+      return Fail;
+    }
+
+    if (command->handler(&tokens[words], argc, self->context) != Success)
+    {
+      _Shell_Text(self, "error\r\n");
+      return Fail;
+    }
+
+    _Shell_Text(self, "ok\r\n");
+    return Success;
+  }
+
+  _Shell_Text(self, "unknown command, try help\r\n");
+
+  return Fail;
+}
+
+void Shell_Print(Shell_DS *const self, const uint8_t str[], size_t len)
+{
+  if (self->print && len)
+    self->print(str, len, self->context);
+}
+
+bool_t Shell_isWord(const Shell_Token_t *const token, const char *word)
+{
+  size_t i = 0;
+
+  for (; word[i]; ++i)
+    if (i == token->len || token->str[i] != (uint8_t)word[i])
+      return False;
+
+  return (i == token->len) ? True : False;
+}
+
+task_t Shell_Unsigned(const Shell_Token_t *const token, uint32_t *const value)
+{
+  if (token->len == 0 || token->len > 10)
+    return Fail;
+
+  uint64_t result = 0;
+
+  for (size_t i = 0; i < token->len; ++i)
+  {
+    const uint8_t c = token->str[i];
+
+    if (c < '0' || c > '9')
+      return Fail;
+
+    result = result * 10 + (c - '0');
+  }
+
+  if (result > 0xFFFFFFFFU)
+    return Fail;
+
+  *value = (uint32_t)result;
+
+  return Success;
+}
+
+/* ---------------------------------------------------------------- Class Public Functions End */
+
+#endif // STM32F103xx_UNREADY
@@ -0,0 +1,399 @@
+#include "Storage.h"
+#include <stdlib.h>
+
+#ifndef STM32F103xx_UNREADY
+
+/** Def. Begin -------------------------------------------------------------------------
+ * @brief
+ * | page:   [ magic ][ sequence ][ record ][ record ] ... [ 0xFFFF ... ]
+ * | record: [ key ][ len ][ data, padded to half words ][ checksum ]
+ *
+ */
+
+#define STORAGE_MAGIC 0x5354U     // * "ST", written last on a formatted page
+#define STORAGE_HEADER 4U         // * bytes of magic & sequence
+#define STORAGE_EMPTY 0xFFFFU     // * erased half word
+#define STORAGE_MAX_LEN 256U      // * bytes of data in one record
+#define STORAGE_TIMEOUT 0x100000U // * try times of one flash operation, a page erase is the longest
+
+/* -------------------------------------------------------------------------- Def. End */
+
+/** Class Private Functions Begin ---------------------------------------------------------------
+ * @brief
+ *
+ */
+
+/**
+ * @brief read one half word from the flash
+ *
+ * @param address: half word aligned
+ * @return uint16_t: half word
+ */
+static inline uint16_t _Storage_Load(const uint32_t address)
+{
+  return *(volatile const uint16_t *)address;
+}
+
+/**
+ * @brief bytes taken by a record in the page
+ *
+ * @param len: bytes of data
+ * @return uint32_t: key, len, padded data & checksum
+ */
+static inline uint32_t _Storage_Size(const uint32_t len)
+{
+  return 6 + ((len + 1) & ~1U);
+}
+
+/**
+ * @brief Fletcher-16 over key, len & data
+ * | both sums stay below 0xFF, the result is never an erased half word.
+ *
+ * @param key: key of the record
+ * @param data: bytes of the record (RAM or flash)
+ * @param len: bytes of data
+ * @return uint16_t: checksum
+ */
+static uint16_t _Storage_Checksum(const uint16_t key, volatile const uint8_t data[], const uint16_t len)
+{
+  uint16_t sum1 = 0, sum2 = 0;
+  const uint8_t head[4] = {(uint8_t)key, (uint8_t)(key >> 8), (uint8_t)len, (uint8_t)(len >> 8)};
+
+  for (size_t i = 0; i < 4 + (size_t)len; ++i)
+  {
+    sum1 = (sum1 + ((i < 4) ? head[i] : data[i - 4])) % 255;
+    sum2 = (sum2 + sum1) % 255;
+  }
+
+  return (uint16_t)((sum2 << 8) | sum1);
+}
+
+/**
+ * @brief check the checksum of a record in the flash
+ *
+ * @param address: first address of the record
+ * @return bool_t: True / False
+ */
+static bool_t _Storage_isValid(const uint32_t address)
+{
+  const uint16_t key = _Storage_Load(address);
+  const uint16_t len = _Storage_Load(address + 2);
+
+  const uint16_t checksum = _Storage_Load(address + _Storage_Size(len) - 2);
+
+  return (checksum == _Storage_Checksum(key, (volatile const uint8_t *)(address + 4), len)) ? True : False;
+}
+
+/**
+ * @brief walk the records of the active page & find the free space
+ * | a broken record (power loss while writing) closes the page, \n
+ * | the next write swaps the page.
+ *
+ * @param self: object pointer
+ */
+static void _Storage_Scan(Storage_DS *const self)
+{
+  const uint32_t end = self->page[self->active] + FLASH_PAGE_SIZE_BYTES;
+  uint32_t address = self->page[self->active] + STORAGE_HEADER;
+
+  while (address < end && _Storage_Load(address) != STORAGE_EMPTY)
+  {
+    const uint16_t len = _Storage_Load(address + 2);
+
+    if (len > STORAGE_MAX_LEN || address + _Storage_Size(len) > end)
+    {
+      address = end;
+      break;
+    }
+
+    address += _Storage_Size(len);
+  }
+
+  self->cursor = address;
+}
+
+/**
+ * @brief find the latest valid record of the key in the active page
+ *
+ * @param self: object pointer
+ * @param key: key of the record
+ * @return uint32_t: first address of the record, 0 -> not found
+ */
+static uint32_t _Storage_Find(Storage_DS *const self, const uint16_t key)
+{
+  uint32_t address = self->page[self->active] + STORAGE_HEADER;
+  uint32_t latest = 0;
+
+  while (address < self->cursor)
+  {
+    const uint32_t size = _Storage_Size(_Storage_Load(address + 2));
+
+    if (address + size > self->cursor)
+      break;
+
+    // ? broken records are skipped, an older one of the same key is still good
+    if (_Storage_Load(address) == key && _Storage_isValid(address))
+      latest = address;
+
+    address += size;
+  }
+
+  return latest;
+}
+
+/**
+ * @brief program one record at the address
+ * @warning flash must be unlocked
+ *
+ * @param address: first address of the record, erased
+ * @param key: key of the record
+ * @param data: bytes of the record (RAM or flash)
+ * @param len: bytes of data
+ * @return task_t: Success / Fail
+ */
+static task_t _Storage_Append(uint32_t address, const uint16_t key, volatile const uint8_t data[], const uint16_t len)
+{
+  // ? key first & checksum last, a broken record never passes the check
+  if (_InterfaceFLASH_Program(address, key, STORAGE_TIMEOUT) != Success)
+    return Fail;
+  if (_InterfaceFLASH_Program(address + 2, len, STORAGE_TIMEOUT) != Success)
+    return Fail;
+
+  address += 4;
+
+  for (size_t i = 0; i < len; i += 2, address += 2)
+  {
+    const uint16_t word = (uint16_t)(data[i] | (((i + 1 < len) ? data[i + 1] : 0xFF) << 8));
+
+    if (_InterfaceFLASH_Program(address, word, STORAGE_TIMEOUT) != Success)
+      return Fail;
+  }
+
+  return _InterfaceFLASH_Program(address, _Storage_Checksum(key, data, len), STORAGE_TIMEOUT);
+}
+
+/**
+ * @brief format a page: erase, then sequence & magic
+ * @warning flash must be unlocked
+ *
+ * @param page: first address of the page
+ * @param sequence: sequence of the page
+ * @return task_t: Success / Fail
+ */
+static task_t _Storage_Format(const uint32_t page, const uint16_t sequence)
+{
+  if (_InterfaceFLASH_ErasePage(page, STORAGE_TIMEOUT) != Success)
+    return Fail;
+
+  if (_InterfaceFLASH_Program(page + 2, sequence, STORAGE_TIMEOUT) != Success)
+    return Fail;
+
+  return _InterfaceFLASH_Program(page, STORAGE_MAGIC, STORAGE_TIMEOUT);
+}
+
+/**
+ * @brief copy the latest records into the other page, then erase the active one
+ * @warning flash must be unlocked
+ *
+ * @param self: object pointer
+ * @return task_t: Success / Fail
+ */
+static task_t _Storage_Swap(Storage_DS *const self)
+{
+  const uint8_t target = self->active ^ 1;
+  uint32_t cursor = self->page[target] + STORAGE_HEADER;
+
+  if (_InterfaceFLASH_ErasePage(self->page[target], STORAGE_TIMEOUT) != Success)
+    return Fail;
+
+  for (uint32_t address = self->page[self->active] + STORAGE_HEADER; address < self->cursor;)
+  {
+    const uint16_t key = _Storage_Load(address);
+    const uint16_t len = _Storage_Load(address + 2);
+
+    // ? only the latest one of each key, removed & broken records are dropped
+    if (len != 0 && _Storage_Find(self, key) == address)
+    {
+      if (_Storage_Append(cursor, key, (volatile const uint8_t *)(address + 4), len) != Success)
+        return Fail;
+
+      cursor += _Storage_Size(len);
+    }
+
+    address += _Storage_Size(len);
+  }
+
+  // ? the target page is valid only after its magic, the old page is still there until now
+  if (_InterfaceFLASH_Program(self->page[target] + 2, self->sequence + 1, STORAGE_TIMEOUT) != Success)
+    return Fail;
+  if (_InterfaceFLASH_Program(self->page[target], STORAGE_MAGIC, STORAGE_TIMEOUT) != Success)
+    return Fail;
+
+  const uint8_t previous = self->active;
+
+  self->active = target;
+  self->sequence++;
+  self->cursor = cursor;
+
+  return _InterfaceFLASH_ErasePage(self->page[previous], STORAGE_TIMEOUT);
+}
+
+/**
+ * @brief append a record, swap the page first if it is full
+ *
+ * @param self: object pointer
+ * @param key: key of the record
+ * @param data: bytes of the record
+ * @param len: bytes of data
+ * @return task_t: Success / Fail
+ */
+static task_t _Storage_Commit(Storage_DS *const self, const uint16_t key, const uint8_t data[], const uint16_t len)
+{
+  task_t result = Success;
+
+  _InterfaceFLASH_Unlock();
+
+  if (self->cursor + _Storage_Size(len) > self->page[self->active] + FLASH_PAGE_SIZE_BYTES)
+    result = _Storage_Swap(self);
+
+  if (result == Success && self->cursor + _Storage_Size(len) > self->page[self->active] + FLASH_PAGE_SIZE_BYTES)
+    result = Fail;
+
+  if (result == Success)
+    result = _Storage_Append(self->cursor, key, data, len);
+
+  _InterfaceFLASH_Lock();
+
+  // ? a failed record is skipped by its length, or it closes the page
+  _Storage_Scan(self);
+
+  return result;
+}
+
+/* ---------------------------------------------------------------- Class Private Functions End */
+
+/** Class Public Functions Begin ---------------------------------------------------------------
+ * @brief
+ *
+ */
+
+Storage_DS *Storage_Constructor(uint32_t first, uint32_t second)
+{
+  if (first == second || _MASK(first, FLASH_PAGE_SIZE_BYTES - 1) || _MASK(second, FLASH_PAGE_SIZE_BYTES - 1))
+    return NULL;
+
+  Storage_DS *obj = (Storage_DS *)calloc(1, sizeof(Storage_DS));
+
+  if (obj == NULL)
+    return NULL;
+
+  obj->page[0] = first;
+  obj->page[1] = second;
+
+  const bool_t isValid[2] = {
+      (_Storage_Load(first) == STORAGE_MAGIC) ? True : False,
+      (_Storage_Load(second) == STORAGE_MAGIC) ? True : False};
+
+  const uint16_t sequence[2] = {_Storage_Load(first + 2), _Storage_Load(second + 2)};
+
+  task_t result = Success;
+
+  _InterfaceFLASH_Unlock();
+
+  if (isValid[0] && isValid[1])
+  {
+    // ? power lost in a swap, the newer page is complete
+    obj->active = ((sint16_t)(sequence[1] - sequence[0]) > 0) ? 1 : 0;
+    result = _InterfaceFLASH_ErasePage(obj->page[obj->active ^ 1], STORAGE_TIMEOUT);
+  }
+  else if (isValid[0] || isValid[1])
+  {
+    obj->active = isValid[0] ? 0 : 1;
+  }
+  else
+  {
+    obj->active = 0;
+    result = _Storage_Format(first, 0);
+  }
+
+  _InterfaceFLASH_Lock();
+
+  if (result != Success)
+  {
+    free(obj);
+    return NULL;
+  }
+
+  obj->sequence = sequence[obj->active];
+  if (!isValid[obj->active])
+    obj->sequence = 0;
+
+  _Storage_Scan(obj);
+
+  return obj;
+}
+
+task_t Storage_Destructor(Storage_DS *const self)
+{
+  free(self);
+
+  return Success;
+}
+
+task_t Storage_Read(Storage_DS *const self, uint16_t key, uint8_t data[], size_t len)
+{
+  if (key == 0 || key == STORAGE_EMPTY || len == 0)
+    return Fail;
+
+  const uint32_t address = _Storage_Find(self, key);
+
+  if (address == 0 || _Storage_Load(address + 2) != len)
+    return Fail;
+
+  volatile const uint8_t *const record = (volatile const uint8_t *)(address + 4);
+
+  for (size_t i = 0; i < len; ++i)
+    data[i] = record[i];
+
+  return Success;
+}
+
+task_t Storage_Write(Storage_DS *const self, uint16_t key, const uint8_t data[], size_t len)
+{
+  if (key == 0 || key == STORAGE_EMPTY || len == 0 || len > STORAGE_MAX_LEN)
+    return Fail;
+
+  const uint32_t address = _Storage_Find(self, key);
+
+  // ? same content, save an erase cycle
+  if (address != 0 && _Storage_Load(address + 2) == len)
+  {
+    volatile const uint8_t *const record = (volatile const uint8_t *)(address + 4);
+    size_t i = 0;
+
+    while (i < len && record[i] == data[i])
+      i++;
+
+    if (i == len)
+      return Success;
+  }
+
+  return _Storage_Commit(self, key, data, (uint16_t)len);
+}
+
+task_t Storage_Remove(Storage_DS *const self, uint16_t key)
+{
+  if (key == 0 || key == STORAGE_EMPTY)
+    return Fail;
+
+  const uint32_t address = _Storage_Find(self, key);
+
+  if (address == 0 || _Storage_Load(address + 2) == 0)
+    return Success;
+
+  return _Storage_Commit(self, key, NULL, 0);
+}
+
+/* ---------------------------------------------------------------- Class Public Functions End */
+
+#endif // STM32F103xx_UNREADY
@@ -0,0 +1,381 @@
+#include "Telemetry.h"
+#include <stdlib.h>
+
+#ifndef STM32F103xx_UNREADY
+
+/** Class Private Functions Begin ---------------------------------------------------------------
+ * @brief
+ *
+ */
+
+/**
+ * @brief append one byte to the frame in progress
+ *
+ * @param self: object pointer
+ * @param byte: to append
+ * @return task_t: Success / Fail (frame full, CRC needs the last 2 bytes)
+ */
+static task_t _Telemetry_Append(Telemetry_DS *const self, const uint8_t byte)
+{
+  if (self->len + 2 >= TELEMETRY_MAX_RAW)
+  {
+    self->isOverflow = True;
+    return Fail;
+  }
+
+  self->raw[self->len++] = byte;
+
+  return Success;
+}
+
+/* ---------------------------------------------------------------- Class Private Functions End */
+
+/** Class Public Functions Begin ---------------------------------------------------------------
+ * @brief
+ *
+ */
+
+Telemetry_DS *Telemetry_Constructor(void)
+{
+  Telemetry_DS *obj = (Telemetry_DS *)calloc(1, sizeof(Telemetry_DS));
+
+  if (obj == NULL)
+    return NULL;
+
+  obj->len = 0;
+  obj->sequence = 0;
+  obj->isOverflow = False;
+
+  return obj;
+}
+
+task_t Telemetry_Destructor(Telemetry_DS *const self)
+{
+  free(self);
+
+  return Success;
+}
+
+void Telemetry_Begin(Telemetry_DS *const self, uint8_t type)
+{
+  self->raw[0] = type;
+  self->raw[1] = self->sequence;
+  self->len = TELEMETRY_HEADER;
+  self->isOverflow = False;
+}
+
+task_t Telemetry_Unsigned(Telemetry_DS *const self, uint32_t value)
+{
+  // ? 7 bits per byte, MSB set on all but the last
+  while (value >= 0x80)
+  {
+    if (_Telemetry_Append(self, (uint8_t)(value | 0x80)) != Success)
+      return Fail;
+
+    value >>= 7;
+  }
+
+  return _Telemetry_Append(self, (uint8_t)value);
+}
+
+task_t Telemetry_Signed(Telemetry_DS *const self, sint32_t value)
+{
+  // ? 0, -1, 1, -2 ... -> 0, 1, 2, 3 ...
+  return Telemetry_Unsigned(self, ((uint32_t)value << 1) ^ (uint32_t)(value >> 31));
+}
+
+task_t Telemetry_End(Telemetry_DS *const self, Buffer_DS *const buffer)
+{
+  if (self->len < TELEMETRY_HEADER)
+    return Fail;
+
+  // ? a frame below the MAX_RAW is one COBS block: one code byte & the delimiter
+  if (self->isOverflow || Buffer_Space(buffer) < Telemetry_Size(self))
+  {
+    // ? the number is used up anyway, the decoder counts the drop by the gap
+    self->sequence++;
+    self->len = 0;
+    return Fail;
+  }
+
+  const uint16_t crc = Telemetry_CRC16(self->raw, self->len);
+
+  self->raw[self->len++] = (uint8_t)(crc >> 8);
+  self->raw[self->len++] = (uint8_t)crc;
+
+  // ? COBS: each zero becomes the distance to the next one, so 0x00 only ends frames
+  size_t start = 0;
+
+  for (size_t i = 0; i <= self->len; ++i)
+  {
+    if (i != self->len && self->raw[i] != 0)
+      continue;
+
+    Buffer_Push(buffer, (uint8_t)(i - start + 1));
+
+    for (size_t j = start; j < i; ++j)
+      Buffer_Push(buffer, self->raw[j]);
+
+    start = i + 1;
+  }
+
+  Buffer_Push(buffer, 0x00);
+
+  self->sequence++;
+  self->len = 0;
+
+  return Success;
+}
+
+size_t Telemetry_Size(const Telemetry_DS *const self)
+{
+  // ? CRC, one COBS code byte & the delimiter
+  return self->len + 2 + 2;
+}
+
+void Telemetry_Decoder_Init(Telemetry_Decoder_DS *const decoder)
+{
+  decoder->len = 0;
+  decoder->remain = decoder->code = 0;
+  decoder->isBroken = False;
+
+  decoder->sequence = 0;
+  decoder->isSynced = False;
+
+  decoder->frames = decoder->lost = decoder->corrupted = 0;
+}
+
+task_t Telemetry_Decode(Telemetry_Decoder_DS *const decoder, uint8_t byte)
+{
+  if (byte != 0x00)
+  {
+    if (decoder->isBroken)
+      return Fail;
+
+    // ? the first byte of a frame, the last good one is given up
+    if (decoder->code == 0)
+      decoder->len = 0;
+
+    if (decoder->remain == 0)
+    {
+      // ? a new block: the last one ended with a zero, unless it was a full block
+      if (decoder->code != 0 && decoder->code != 0xFF)
+      {
+        if (decoder->len == TELEMETRY_MAX_RAW)
+        {
+          decoder->isBroken = True;
+          return Fail;
+        }
+
+        decoder->frame[decoder->len++] = 0x00;
+      }
+
+      decoder->code = byte;
+      decoder->remain = byte - 1;
+
+      return Fail;
+    }
+
+    if (decoder->len == TELEMETRY_MAX_RAW)
+    {
+      decoder->isBroken = True;
+      return Fail;
+    }
+
+    decoder->frame[decoder->len++] = byte;
+    decoder->remain--;
+
+    return Fail;
+  }
+
+  // ? delimiter: check the frame, then start over
+  const bool_t isEmpty = (decoder->code == 0 && !decoder->isBroken) ? True : False;
+  bool_t isGood = False;
+
+  if (!decoder->isBroken && decoder->remain == 0 && decoder->len >= TELEMETRY_HEADER + 2)
+  {
+    const uint16_t crc = (uint16_t)((decoder->frame[decoder->len - 2] << 8) | decoder->frame[decoder->len - 1]);
+
+    isGood = (Telemetry_CRC16(decoder->frame, decoder->len - 2) == crc) ? True : False;
+  }
+
+  const size_t len = decoder->len;
+
+  decoder->len = 0;
+  decoder->remain = decoder->code = 0;
+  decoder->isBroken = False;
+
+  // ? back to back delimiters are no frame
+  if (isEmpty)
+    return Fail;
+
+  if (!isGood)
+  {
+    decoder->corrupted++;
+    return Fail;
+  }
+
+  if (decoder->isSynced)
+    decoder->lost += (uint8_t)(decoder->frame[1] - decoder->sequence);
+
+  decoder->sequence = decoder->frame[1] + 1;
+  decoder->isSynced = True;
+  decoder->frames++;
+
+  // ? CRC stays in the array, len only covers type, sequence & fields
+  decoder->len = len - 2;
+
+  return Success;
+}
+
+task_t Telemetry_ReadUnsigned(const uint8_t frame[], size_t len, size_t *const offset, uint32_t *const value)
+{
+  uint32_t result = 0;
+
+  for (size_t shift = 0, i = *offset; i < len && shift < 35; shift += 7, ++i)
+  {
+    result |= (uint32_t)(frame[i] & 0x7F) << shift;
+
+    if (!_MASK(frame[i], 0x80))
+    {
+      *offset = i + 1;
+      *value = result;
+      return Success;
+    }
+  }
+
+  return Fail;
+}
+
+task_t Telemetry_ReadSigned(const uint8_t frame[], size_t len, size_t *const offset, sint32_t *const value)
+{
+  uint32_t zigzag = 0;
+
+  if (Telemetry_ReadUnsigned(frame, len, offset, &zigzag) != Success)
+    return Fail;
+
+  *value = (sint32_t)(zigzag >> 1) ^ -(sint32_t)(zigzag & 1);
+
+  return Success;
+}
+
+Telemetry_Stream_DS *Telemetry_Stream_Constructor(size_t channels, uint16_t interval)
+{
+  if (channels == 0 || channels > 16 || interval == 0)
+    return NULL;
+
+  Telemetry_Stream_DS *obj = (Telemetry_Stream_DS *)calloc(1, sizeof(Telemetry_Stream_DS));
+
+  if (obj == NULL)
+    return NULL;
+
+  obj->last = (sint32_t *)calloc(channels, sizeof(sint32_t));
+
+  if (obj->last == NULL)
+  {
+    free(obj);
+    return NULL;
+  }
+
+  obj->channels = channels;
+  obj->interval = interval;
+  obj->lost = 0;
+
+  Telemetry_Stream_Reset(obj);
+
+  return obj;
+}
+
+task_t Telemetry_Stream_Destructor(Telemetry_Stream_DS *const self)
+{
+  if (self == NULL)
+    return Success;
+
+  free(self->last);
+  free(self);
+
+  return Success;
+}
+
+void Telemetry_Stream_Reset(Telemetry_Stream_DS *const self)
+{
+  self->count = 0;
+  self->isSynced = False;
+}
+
+task_t Telemetry_Stream_Encode(Telemetry_Stream_DS *const self, Telemetry_DS *const telemetry, uint8_t type, const sint32_t values[])
+{
+  // ? a decoder joining late, or one that lost a frame, is back in sync at the next keyframe
+  const bool_t isKey = (self->count == 0) ? True : False;
+
+  Telemetry_Begin(telemetry, isKey ? (uint8_t)(type | TELEMETRY_KEYFRAME) : (uint8_t)(type & ~TELEMETRY_KEYFRAME));
+
+  for (size_t i = 0; i < self->channels; ++i)
+  {
+    // ? wrapping difference, counters (e.g. timestamps) cross 0xFFFFFFFF without a jump
+    const sint32_t field = isKey ? values[i] : (sint32_t)((uint32_t)values[i] - (uint32_t)self->last[i]);
+
+    if (Telemetry_Signed(telemetry, field) != Success)
+    {
+      Telemetry_Stream_Reset(self);
+      return Fail;
+    }
+
+    self->last[i] = values[i];
+  }
+
+  self->count = (self->count + 1 >= self->interval) ? 0 : self->count + 1;
+
+  return Success;
+}
+
+task_t Telemetry_Stream_Decode(Telemetry_Stream_DS *const self, const Telemetry_Decoder_DS *const decoder, size_t *const offset, sint32_t values[])
+{
+  const bool_t isKey = _MASK(decoder->frame[0], TELEMETRY_KEYFRAME) ? True : False;
+
+  // ? a lost frame of any type may have been a delta of this stream
+  if (decoder->lost != self->lost)
+    self->isSynced = False;
+
+  self->lost = decoder->lost;
+
+  if (!isKey && !self->isSynced)
+    return Fail;
+
+  for (size_t i = 0; i < self->channels; ++i)
+  {
+    sint32_t field = 0;
+
+    if (Telemetry_ReadSigned(decoder->frame, decoder->len, offset, &field) != Success)
+    {
+      self->isSynced = False;
+      return Fail;
+    }
+
+    self->last[i] = isKey ? field : (sint32_t)((uint32_t)self->last[i] + (uint32_t)field);
+    values[i] = self->last[i];
+  }
+
+  self->isSynced = True;
+
+  return Success;
+}
+
+uint16_t Telemetry_CRC16(const uint8_t array[], size_t len)
+{
+  uint16_t crc = 0xFFFF;
+
+  for (size_t i = 0; i < len; ++i)
+  {
+    crc ^= (uint16_t)(array[i] << 8);
+
+    for (size_t bit = 0; bit < 8; ++bit)
+      crc = _MASK(crc, 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+  }
+
+  return crc;
+}
+
+/* ---------------------------------------------------------------- Class Public Functions End */
+
+#endif // STM32F103xx_UNREADY
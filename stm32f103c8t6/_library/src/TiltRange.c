@@ -0,0 +1,123 @@
+#include "TiltRange.h"
+#include <stdlib.h>
+
+#ifndef STM32F103xx_UNREADY
+
+/** Class Public Functions Begin ---------------------------------------------------------------
+ * @brief
+ *
+ */
+
+TiltRange_DS *TiltRange_Constructor(const TiltRange_Config_t *const config, size_t depth)
+{
+  if (depth == 0 || config->maxRate > 0xFFFF)
+    return NULL;
+
+  TiltRange_DS *obj = (TiltRange_DS *)calloc(1, sizeof(TiltRange_DS));
+
+  if (obj == NULL)
+    return NULL;
+
+  obj->history.array = (TiltRange_Attitude_t *)calloc(depth, sizeof(TiltRange_Attitude_t));
+
+  if (obj->history.array == NULL)
+  {
+    free(obj);
+    return NULL;
+  }
+
+  obj->history.head = obj->history.tail = 0;
+  obj->history.size = depth;
+
+  for (size_t i = 0; i < 3; ++i)
+    obj->axis[i] = config->axis[i];
+
+  obj->maxRate = config->maxRate * config->maxRate;
+  obj->maxSkew = config->maxSkew;
+
+  return obj;
+}
+
+task_t TiltRange_Destructor(TiltRange_DS *const self)
+{
+  if (self == NULL)
+    return Success;
+
+  free(self->history.array);
+  free(self);
+
+  return Success;
+}
+
+void TiltRange_Push(TiltRange_DS *const self, uint32_t timestamp, const q15_t gravity[3], const sint16_t gyro[3])
+{
+  // ? drop the oldest one when full
+  if (self->history.tail - self->history.head == self->history.size)
+    self->history.head++;
+
+  TiltRange_Attitude_t *const entry = &self->history.array[self->history.tail % self->history.size];
+
+  entry->timestamp = timestamp;
+
+  for (size_t i = 0; i < 3; ++i)
+    entry->gravity[i] = gravity[i];
+
+  // ? |gyro| ^ 2 < 3 * 2^30, no overflow in 32 bits
+  entry->rate = (uint32_t)(gyro[0] * gyro[0]) + (uint32_t)(gyro[1] * gyro[1]) + (uint32_t)(gyro[2] * gyro[2]);
+
+  self->history.tail++;
+}
+
+task_t TiltRange_Measure(TiltRange_DS *const self, uint32_t timestamp, uint32_t window, uint16_t distance, TiltRange_Result_t *const result)
+{
+  if (self->history.tail == self->history.head)
+    return Fail;
+
+  const TiltRange_Attitude_t *nearest = NULL;
+  uint32_t skew = 0xFFFFFFFF;
+  bool_t isMoving = False;
+
+  for (size_t i = self->history.head; i != self->history.tail; ++i)
+  {
+    const TiltRange_Attitude_t *const entry = &self->history.array[i % self->history.size];
+
+    // ? timestamps wrap around, compare by the signed difference
+    const sint32_t diff = (sint32_t)(entry->timestamp - timestamp);
+    const uint32_t gap = (uint32_t)((diff < 0) ? -diff : diff);
+
+    if (gap < skew)
+    {
+      skew = gap;
+      nearest = entry;
+    }
+
+    if (gap <= window && entry->rate > self->maxRate)
+      isMoving = True;
+  }
+
+  // cos = boresight . gravity, Q15
+  sint64_t dot = 0;
+  for (size_t i = 0; i < 3; ++i)
+    dot += (sint32_t)self->axis[i] * nearest->gravity[i];
+
+  sint32_t cosine = (sint32_t)(dot >> 15);
+  if (cosine > 32767)
+    cosine = 32767;
+  if (cosine < -32767)
+    cosine = -32767;
+
+  const uint32_t sine = Fusion_Sqrt((uint32_t)FUSION_ONE_Q30 - (uint32_t)(cosine * cosine));
+  const uint32_t along = (uint32_t)((cosine < 0) ? -cosine : cosine);
+
+  result->vertical = (uint16_t)((distance * along) >> 15);
+  result->horizontal = (uint16_t)((distance * sine) >> 15);
+  result->cosine = (q15_t)cosine;
+  result->isMoving = isMoving;
+  result->isAligned = (skew <= self->maxSkew) ? True : False;
+
+  return Success;
+}
+
+/* ---------------------------------------------------------------- Class Public Functions End */
+
+#endif // STM32F103xx_UNREADY
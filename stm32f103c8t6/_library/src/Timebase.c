@@ -0,0 +1,181 @@
+#include "Timebase.h"
+#include <stdlib.h>
+
+#ifndef STM32F103xx_UNREADY
+
+/** Def. Begin -------------------------------------------------------------------------
+ * @brief
+ *
+ */
+
+#define TIMEBASE_RATE_GAIN 3    // * measured rate weighs 1 / 8
+#define TIMEBASE_OFFSET_GAIN 2  // * measured offset weighs 1 / 4
+#define TIMEBASE_RATE_LIMIT 4   // * rate off by more than 1 / 16 -> counter reset, anchor again
+
+/* -------------------------------------------------------------------------- Def. End */
+
+/** Class Private Functions Begin ---------------------------------------------------------------
+ * @brief
+ *
+ */
+
+/**
+ * @brief remote ticks from the anchor, negative before it
+ *
+ * @param self: object pointer
+ * @param remote: remote ticks
+ * @return sint32_t: ticks
+ */
+static sint32_t _Timebase_Clock_Span(Timebase_Clock_DS *const self, const uint32_t remote)
+{
+  const uint32_t span = (remote - self->anchor.remote) & self->mask;
+
+  return (span > (self->mask >> 1)) ? -(sint32_t)(self->mask - span + 1) : (sint32_t)span;
+}
+
+/* ---------------------------------------------------------------- Class Private Functions End */
+
+/** Class Public Functions Begin ---------------------------------------------------------------
+ * @brief
+ *
+ */
+
+Timebase_DS *Timebase_Constructor(uint32_t coreClock)
+{
+  if (coreClock < 1000000)
+    return NULL;
+
+  Timebase_DS *obj = (Timebase_DS *)calloc(1, sizeof(Timebase_DS));
+
+  if (obj == NULL)
+    return NULL;
+
+  obj->cyclesPerMicro = coreClock / 1000000;
+
+  // ? DWT is gated by the trace enable of the debug monitor
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  obj->epoch[0].cycles = obj->epoch[1].cycles = 0;
+  obj->epoch[0].micros = obj->epoch[1].micros = 0;
+  obj->sequence = 0;
+
+  return obj;
+}
+
+task_t Timebase_Destructor(Timebase_DS *const self)
+{
+  free(self);
+
+  return Success;
+}
+
+void Timebase_Tick(Timebase_DS *const self)
+{
+  const uint32_t sequence = self->sequence;
+  const uint32_t cycles = DWT->CYCCNT;
+
+  const uint32_t micros = (cycles - self->epoch[sequence & 1].cycles) / self->cyclesPerMicro;
+
+  // ? keep the remainder cycles in the next epoch, no drift between ticks
+  self->epoch[(sequence + 1) & 1].micros = self->epoch[sequence & 1].micros + micros;
+  self->epoch[(sequence + 1) & 1].cycles = self->epoch[sequence & 1].cycles + micros * self->cyclesPerMicro;
+
+  self->sequence = sequence + 1;
+}
+
+uint32_t Timebase_Micros(Timebase_DS *const self)
+{
+  uint32_t sequence, cycles, micros;
+
+  // ? a tick may land in between, read again with the epoch it wrote
+  do
+  {
+    sequence = self->sequence;
+    micros = self->epoch[sequence & 1].micros;
+    cycles = DWT->CYCCNT - self->epoch[sequence & 1].cycles;
+  } while (sequence != self->sequence);
+
+  return micros + cycles / self->cyclesPerMicro;
+}
+
+Timebase_Clock_DS *Timebase_Clock_Constructor(uint32_t mask, uint32_t rate, uint32_t minSpan)
+{
+  // ? mask must be (2 ^ n) - 1
+  if (mask == 0 || _MASK(mask, mask + 1) || rate == 0 || minSpan == 0 || minSpan > (mask >> 1))
+    return NULL;
+
+  Timebase_Clock_DS *obj = (Timebase_Clock_DS *)calloc(1, sizeof(Timebase_Clock_DS));
+
+  if (obj == NULL)
+    return NULL;
+
+  obj->mask = mask;
+  obj->rate = rate;
+  obj->minSpan = minSpan;
+  obj->anchor.remote = obj->anchor.local = 0;
+  obj->isLocked = False;
+
+  return obj;
+}
+
+task_t Timebase_Clock_Destructor(Timebase_Clock_DS *const self)
+{
+  free(self);
+
+  return Success;
+}
+
+void Timebase_Clock_Observe(Timebase_Clock_DS *const self, uint32_t remote, uint32_t local)
+{
+  remote &= self->mask;
+
+  if (!self->isLocked)
+  {
+    self->anchor.remote = remote;
+    self->anchor.local = local;
+    self->isLocked = True;
+    return;
+  }
+
+  const sint32_t span = _Timebase_Clock_Span(self, remote);
+
+  // ? too short to tell the rate from the jitter of the readings
+  if (span >= 0 && (uint32_t)span < self->minSpan)
+    return;
+
+  const sint64_t measured = (span > 0) ? ((sint64_t)(local - self->anchor.local) << 16) / span : -1;
+  const sint64_t error = measured - self->rate;
+
+  // ? counter reset, missed wraps or a pause of the device: start again from here
+  if (measured < 0 || error > (sint64_t)(self->rate >> TIMEBASE_RATE_LIMIT) || -error > (sint64_t)(self->rate >> TIMEBASE_RATE_LIMIT))
+  {
+    self->anchor.remote = remote;
+    self->anchor.local = local;
+    return;
+  }
+
+  const uint32_t predicted = Timebase_Clock_Convert(self, remote);
+
+  self->rate = (uint32_t)(self->rate + (error >> TIMEBASE_RATE_GAIN));
+
+  self->anchor.remote = remote;
+  self->anchor.local = predicted + ((sint32_t)(local - predicted) >> TIMEBASE_OFFSET_GAIN);
+}
+
+uint32_t Timebase_Clock_Convert(Timebase_Clock_DS *const self, uint32_t remote)
+{
+  const sint64_t span = _Timebase_Clock_Span(self, remote & self->mask);
+
+  return self->anchor.local + (uint32_t)((span * self->rate) >> 16);
+}
+
+uint32_t Timebase_Clock_Scale(Timebase_Clock_DS *const self, uint32_t ticks)
+{
+  return (uint32_t)(((uint64_t)ticks * self->rate) >> 16);
+}
+
+/* ---------------------------------------------------------------- Class Public Functions End */
+
+#endif // STM32F103xx_UNREADY
@@ -25,11 +25,22 @@ VL53L1X_DS *VL53L1X_Constructor(I2C_TypeDef *I2Cx, const uint8_t address)
   obj->I2Cx = I2Cx;
   obj->address = address;
 
+  obj->irq.isBound = False;
+  obj->irq.polarity = 1;
+  obj->irq.isPending = False;
+  obj->irq.timestamp = 0;
+
   return obj;
 }
 
 task_t VL53L1X_Destructor(VL53L1X_DS *const self)
 {
+  if (self == NULL)
+    return Success;
+
+  if (self->irq.isBound)
+    _InterfaceEXTI_Unbind(self->irq.line.order);
+
   free(self);
 
   return Success;
@@ -322,6 +333,104 @@ task_t VL53L1X_StopRanging(VL53L1X_DS *const self)
   return VL53L1X_TxSeries(self, 0x0087, &command, 1);
 }
 
+task_t VL53L1X_SetTimingBudget(VL53L1X_DS *const self, uint16_t budget)
+{
+  // ? ms, RANGE_CONFIG__TIMEOUT_MACROP_A & _B of the long distance mode (UM2510)
+  static const uint16_t budgetTable[][3] = {
+      {20, 0x001E, 0x0022},
+      {33, 0x0060, 0x006E},
+      {50, 0x00AD, 0x00C6},
+      {100, 0x01CC, 0x01EA},
+      {200, 0x02D9, 0x02F8},
+      {500, 0x048F, 0x04A4}};
+
+  for (size_t i = 0; i < sizeof(budgetTable) / sizeof(budgetTable[0]); ++i)
+  {
+    if (budgetTable[i][0] != budget)
+      continue;
+
+    const uint8_t macroA[2] = {(uint8_t)(budgetTable[i][1] >> 8), (uint8_t)budgetTable[i][1]};
+    const uint8_t macroB[2] = {(uint8_t)(budgetTable[i][2] >> 8), (uint8_t)budgetTable[i][2]};
+
+    // ? RANGE_CONFIG__TIMEOUT_MACROP_A_HI: 0x005E, RANGE_CONFIG__TIMEOUT_MACROP_B_HI: 0x0061
+    if (VL53L1X_TxSeries(self, 0x005E, macroA, 2) != Success)
+      return Fail;
+    if (VL53L1X_TxSeries(self, 0x0061, macroB, 2) != Success)
+      return Fail;
+
+    // ? RESULT__OSC_CALIBRATE_VAL: 0x00DE, oscillator ticks per ms in 10 bits
+    volatile uint8_t osc[2] = {0};
+
+    if (VL53L1X_RxSeries(self, 0x00DE, osc, 2) != Success)
+      return Fail;
+
+    // ? one ranging right after another: the period is the budget, 7.5 % margin on the oscillator
+    const uint32_t clock = (uint32_t)(_MASK(osc[0], 0x03) << 8) | osc[1];
+    const uint32_t period = clock * budget * 1075 / 1000;
+    const uint8_t array[4] = {(uint8_t)(period >> 24), (uint8_t)(period >> 16), (uint8_t)(period >> 8), (uint8_t)period};
+
+    // ? SYSTEM__INTERMEASUREMENT_PERIOD: 0x006C
+    return VL53L1X_TxSeries(self, 0x006C, array, 4);
+  }
+
+  return Fail;
+}
+
+task_t VL53L1X_BindInterrupt(VL53L1X_DS *const self, const port_t *const line)
+{
+  if (line->order > 15)
+    return Fail;
+
+  volatile uint8_t polarity = 0x00;
+
+  if (VL53L1X_GetInterruptPolarity(self, &polarity) != Success)
+    return Fail;
+
+  self->irq.line.GPIOx = line->GPIOx;
+  self->irq.line.order = line->order;
+  self->irq.polarity = polarity;
+  self->irq.isPending = False;
+
+  _InterfaceEXTI_Bind(line, polarity ? EXTI_RISING : EXTI_FALLING);
+  self->irq.isBound = True;
+
+  return Success;
+}
+
+void VL53L1X_IRQHandler(VL53L1X_DS *const self, const uint32_t timestamp)
+{
+  if (!self->irq.isBound || !_InterfaceEXTI_isPending(self->irq.line.order))
+    return;
+
+  _InterfaceEXTI_Clear(self->irq.line.order);
+
+  self->irq.timestamp = timestamp;
+  self->irq.isPending = True;
+}
+
+bool_t VL53L1X_TakeInterrupt(VL53L1X_DS *const self, volatile uint32_t *const timestamp)
+{
+  if (!self->irq.isBound)
+    return False;
+
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  // ? an uncleared interrupt keeps GPIO1 active, its next edge never comes
+  bool_t isReady = self->irq.isPending;
+  if ((_MASK(self->irq.line.GPIOx->IDR, _BIT(self->irq.line.order)) ? 1 : 0) == self->irq.polarity)
+    isReady = True;
+
+  self->irq.isPending = False;
+
+  if (isReady && timestamp)
+    *timestamp = self->irq.timestamp;
+
+  __set_PRIMASK(primask);
+
+  return isReady;
+}
+
 /* ---------------------------------------------------------------- Class Public Functions End */
 
 #endif // STM32F103xx_UNREADY
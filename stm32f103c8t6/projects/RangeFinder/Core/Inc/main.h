@@ -49,13 +49,23 @@ extern "C"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "Common.h"
+#include "Timebase.h"
 #include "Buffer.h"
+#include "Format.h"
+#include "Storage.h"
 #include "Button.h"
 #include "HC05.h"
+#include "Shell.h"
+#include "Telemetry.h"
+#include "SPIBus.h"
 #include "LSM6DS3.h"
+#include "Fusion.h"
+#include "TiltRange.h"
+#include "RangeGate.h"
 #include "VL53L1X.h"
 // #include "VL53L1X_api.h"
 #include "SevenSegment.h"
+#include "Display.h"
   /* USER CODE END Includes */
 
   /* Exported types ------------------------------------------------------------*/
@@ -66,6 +76,11 @@ extern "C"
   /* Exported constants --------------------------------------------------------*/
   /* USER CODE BEGIN EC */
 
+// ? board reworks, 0 -> the board as built (refer to _diagram/Layout.pdf)
+#define BOARD_IMU_INT 0 // * 1: LSM6DS3 INT1 lifted from GND & wired to PA0, INT2 wired to PA1
+#define BOARD_TOF_INT 0 // * 1: VL53L1X GPIO1 wired to PA2
+#define BOARD_HC05_FLOW 0 // * 1: HC-05 RTS wired to PA11 (CTS), CTS wired to PA12 (RTS)
+
   /* USER CODE END EC */
 
   /* Exported macro ------------------------------------------------------------*/
@@ -82,11 +97,27 @@ extern "C"
   void APP_SysTick_Handler(void);
   void APP_TIM4_IRQHandler(void);
   void APP_USART1_IRQHandler(void);
+  void APP_DMA1_Channel2_IRQHandler(void);
+  void APP_DMA1_Channel3_IRQHandler(void);
+  void APP_DMA1_Channel4_IRQHandler(void);
+  void APP_DMA1_Channel5_IRQHandler(void);
+  void APP_EXTI0_IRQHandler(void);
+  void APP_EXTI1_IRQHandler(void);
+  void APP_EXTI2_IRQHandler(void);
 /* USER CODE END EFP */
 
 /* Private defines -----------------------------------------------------------*/
 #define TEST_Pin LL_GPIO_PIN_13
 #define TEST_GPIO_Port GPIOC
+#define INT1_Pin LL_GPIO_PIN_0
+#define INT1_GPIO_Port GPIOA
+#define INT1_EXTI_IRQn EXTI0_IRQn
+#define INT2_Pin LL_GPIO_PIN_1
+#define INT2_GPIO_Port GPIOA
+#define INT2_EXTI_IRQn EXTI1_IRQn
+#define TOF_INT_Pin LL_GPIO_PIN_2
+#define TOF_INT_GPIO_Port GPIOA
+#define TOF_INT_EXTI_IRQn EXTI2_IRQn
 #define SCS_Pin LL_GPIO_PIN_4
 #define SCS_GPIO_Port GPIOA
 #define SCLK_Pin LL_GPIO_PIN_5
@@ -6,13 +6,46 @@ typedef enum
 {
   Nothing = 0x00,
   HC05_WAIT = 0x01,
-  HC05_BUSY = 0x10,
   LSM6DS3_WAIT = 0x02,
   LSM6DS3_BUSY = 0x20,
   VL53L1X_WAIT = 0x03,
   VL53L1X_BUSY = 0x30
 } APP_FLAG_Enum;
 
+#define LSM6DS3_FIFO_SAMPLES 32 // * gyro & acce patterns drained per watermark
+#define LSM6DS3_FIFO_RAW (2 * 6 * (LSM6DS3_FIFO_SAMPLES + 1)) // * raw bytes, with room for a broken pattern
+#define LSM6DS3_FIFO_TICKS 96    // * timestamp ticks between patterns, 416 Hz at 25 us per tick (doubled per lower ODR)
+
+#define LSM6DS3_CAL_SAMPLES 416 // * samples averaged by the calibration, 1 s at 416 Hz
+#define LSM6DS3_CAL_STILL 115    // * gyro counts, 2 dps spread at +-500 dps
+
+#define GATE_STILL 3000   // * ms without motion before the ranging is suspended
+#define GATE_BAND 20      // * mm, spread of stable distances
+#define GATE_WINDOW 8     // * distances checked for stability
+#define GATE_VARIANCE 400 // * gyro counts ^ 2, 0.35 dps deviation at +-500 dps
+
+#define STORAGE_PAGE_A 0x0800F800 // * last 2 KB of the 64 KB flash, out of the program image
+#define STORAGE_PAGE_B 0x0800FC00
+#define STORAGE_KEY_IMU_BIAS 0x0001
+#define STORAGE_KEY_HC05_BAUD 0x0002
+
+#define HC05_TIMEOUT 100000 // * try times of each byte of an AT answer, about 10 ms
+#define HC05_LINK_BAUD 115200 // * data mode rate set up in AT mode (button held at power-up)
+#define HC05_TX_TIMEOUT 100000 // * try times for room of a shell answer, about 10 ms
+
+#define TELEMETRY_ATTITUDE 0x01 // * stream: roll, pitch (0.01 degree), timestamp (us)
+#define TELEMETRY_DISTANCE 0x02 // * stream: distance (mm), timestamp (us), horizontal distance (mm)
+#define TELEMETRY_ATTITUDE_KEY 16 // * attitude frames from one keyframe to the next, about 1.2 s
+#define TELEMETRY_DISTANCE_KEY 8  // * distance frames from one keyframe to the next, about 0.8 s
+#define TELEMETRY_DISTANCE_WAIT 10000 // * try times for room of a distance frame, about 1 ms
+
+#define TIMEBASE_MIN_SPAN 40000 // * LSM6DS3 ticks between rate updates of its clock, 1 s
+
+#define VL53L1X_BUDGET 100000 // * us, default timing budget, "tof budget" changes it
+#define TILT_HISTORY 64       // * attitudes kept, about 150 ms at 416 Hz
+#define TILT_MAX_RATE 1143    // * gyro counts, 20 dps at +-500 dps
+#define TILT_MAX_SKEW 10000   // * us
+
 /** Class Private Variables Begin ---------------------------------------------------------------
  * @brief
  *
@@ -21,29 +54,96 @@ typedef enum
 static struct
 {
 
+  struct
+  {
+    Timebase_DS *restrict device;
+    Timebase_Clock_DS *restrict imu; // * LSM6DS3 timestamp mapped onto the timebase
+  } timebase;
+
   struct
   {
     HC05_DS *restrict device;
-    Buffer_DS *restrict rx;
+    Buffer_DS *restrict rx; // * bytes of the latest frame from the host
     Buffer_DS *restrict tx;
+    bool_t isFrame; // * rx holds a complete frame
   } hc05;
 
+  struct
+  {
+    Telemetry_DS *restrict device; // * binary frames of the samples, straight into hc05.tx
+    Telemetry_Stream_DS *restrict attitude;
+    Telemetry_Stream_DS *restrict distance;
+    bool_t isStreaming; // * "stream on / off"
+    uint32_t sent;      // * frames put into hc05.tx
+    uint32_t dropped;   // * frames without room in hc05.tx
+    uint32_t evicted;   // * HC05_GetDropped() seen last, older frames removed for new ones
+  } telemetry;
+
+  struct
+  {
+    Shell_DS *restrict device; // * command lines from the host, in the frames of hc05.rx
+  } shell;
+
   struct
   {
     LSM6DS3_DS *restrict device;
     Buffer_DS *restrict buffer;
+    LSM6DS3_Config_t config;   // * applied, "rate imu" changes both ODR
+    LSM6DS3_FIFOConfig_t fifo; // * applied, "rate imu" changes the ODR
+    uint32_t ticks;            // * timestamp ticks between patterns at the ODR of fifo
+    LSM6DS3_Sample_t samples[LSM6DS3_FIFO_SAMPLES];
+    volatile size_t count;
+    volatile uint8_t raw[LSM6DS3_FIFO_RAW];
+    volatile bool_t isDraining, isDrained;
+    volatile uint32_t timestamp; // * us, watermark edge (or poll) of the last drain
   } lsm6ds3;
 
+  struct
+  {
+    SPIBus_DS *restrict bus;
+  } spi;
+
+  struct
+  {
+    Storage_DS *restrict device;
+  } storage;
+
+  struct
+  {
+    volatile flag8_t events; // * refer to LSM6DS3_Event_Enum
+    uint32_t polled;         // * tick of the last read of the sources, without INT2
+  } motion;
+
+  struct
+  {
+    RangeGate_DS *restrict device;
+    volatile bool_t isRanging; // * VL53L1X is ranging
+  } gate;
+
+  struct
+  {
+    Fusion_DS *restrict device;
+    sint16_t roll, pitch; // * 0.01 degree
+  } fusion;
+
   struct
   {
     VL53L1X_DS *restrict device;
-    uint16_t distance;
+    uint16_t distance;           // * mm, raw slant distance along the boresight
+    uint32_t budget;             // * us, timing budget of each ranging
+    volatile uint32_t timestamp; // * us, data ready edge (or poll) of the last distance
   } vl53l1x;
 
   struct
   {
-    SevenSegment_DS *restrict device[3];
-    uint8_t number[3];
+    TiltRange_DS *restrict device;
+    TiltRange_Result_t result;
+    uint16_t horizontal; // * mm, distance under gravity, the raw one when no attitude is aligned
+  } tilt;
+
+  struct
+  {
+    Display_DS *restrict device; // * 3 digits, the distance in m
   } display;
 
   struct
@@ -54,6 +154,8 @@ static struct
 
   volatile flag8_t schedule;
 
+  volatile uint32_t tick; // * ms, counted by SysTick
+
 } app;
 
 /* ---------------------------------------------------------------- Class Private Variables End */
@@ -64,17 +166,44 @@ static struct
  */
 
 // ! Private
+// ? Timebase -----------------------------------------------------------------------------------
+static task_t Timebase_Init(void);
+static uint32_t Timebase_Now(void);
+
 // ? HC05 ---------------------------------------------------------------------------------------
 static task_t HC05_Init(void);
+static task_t HC05_Baud(void);
 static task_t HC05_Printf(const uint8_t str[], size_t len);
+static task_t HC05_Task(void);
+
+// ? Telemetry ----------------------------------------------------------------------------------
+static task_t Telemetry_Init(void);
+static task_t Telemetry_Send(Telemetry_Stream_DS *const stream, uint8_t type, const sint32_t values[], HC05_Policy_Enum policy, uint32_t timeout);
+
+// ? Shell --------------------------------------------------------------------------------------
+static task_t Shell_Init(void);
+static task_t Shell_Task(void);
+static void Shell_Output(const uint8_t str[], size_t len, void *context);
+static void Shell_Value(const char *label, uint32_t value, const char *unit);
+static task_t Shell_Rate(const Shell_Token_t args[], size_t argc, void *context);
+static task_t Shell_Budget(const Shell_Token_t args[], size_t argc, void *context);
+static task_t Shell_Stats(const Shell_Token_t args[], size_t argc, void *context);
+static task_t Shell_Stream(const Shell_Token_t args[], size_t argc, void *context);
+
+// ? Storage ------------------------------------------------------------------------------------
+static task_t Storage_Init(void);
 
 // ? LSM6DS3 ------------------------------------------------------------------------------------
 static task_t LSM6DS3_Init(void);
+static task_t LSM6DS3_Calibration(void);
 static task_t LSM6DS3_Task(void);
+static void LSM6DS3_Drained(task_t result, void *context);
+static task_t Motion_Task(void);
 
 // ? VL53L1X ------------------------------------------------------------------------------------
 static task_t VL53L1X_Init(void);
 static task_t VL53L1X_Task(void);
+static task_t Gate_Task(void);
 
 // ? Seven Segment ------------------------------------------------------------------------------
 static task_t SevenSegment_Init(void);
@@ -98,6 +227,17 @@ void APP_TIM4_IRQHandler(void);
 // ? USART1 IT ----------------------------------------------------------------------------------
 void APP_USART1_IRQHandler(void);
 
+// ? DMA1 IT ------------------------------------------------------------------------------------
+void APP_DMA1_Channel2_IRQHandler(void);
+void APP_DMA1_Channel3_IRQHandler(void);
+void APP_DMA1_Channel4_IRQHandler(void);
+void APP_DMA1_Channel5_IRQHandler(void);
+
+// ? EXTI IT ------------------------------------------------------------------------------------
+void APP_EXTI0_IRQHandler(void);
+void APP_EXTI1_IRQHandler(void);
+void APP_EXTI2_IRQHandler(void);
+
 /* ------------------------------------------------------- Class Functions Forward Declare End */
 
 /** Class Private Functions Begin ---------------------------------------------------------------
@@ -105,12 +245,31 @@ void APP_USART1_IRQHandler(void);
  *
  */
 
+// ? Timebase -----------------------------------------------------------------------------------
+static task_t Timebase_Init(void)
+{
+  app.timebase.device = Timebase_Constructor(SystemCoreClock);
+  app.timebase.imu = Timebase_Clock_Constructor(LSM6DS3_TIMESTAMP_MASK, LSM6DS3_TIMESTAMP_US << 16, TIMEBASE_MIN_SPAN);
+
+  if (!app.timebase.device)
+    return Fail;
+  if (!app.timebase.imu)
+    return Fail;
+
+  return Success;
+}
+
+static uint32_t Timebase_Now(void)
+{
+  return app.timebase.device ? Timebase_Micros(app.timebase.device) : 0;
+}
+
 // ? HC05 ---------------------------------------------------------------------------------------
 static task_t HC05_Init(void)
 {
   app.hc05.device = HC05_Constructor(USART1);
-  app.hc05.tx = Buffer_Constructor(20);
-  app.hc05.rx = Buffer_Constructor(10);
+  app.hc05.tx = Buffer_Constructor(64);
+  app.hc05.rx = Buffer_Constructor(64);
 
   if (!app.hc05.device)
     return Fail;
@@ -119,103 +278,608 @@ static task_t HC05_Init(void)
   if (!app.hc05.rx)
     return Fail;
 
+  // ? AT goes by polling, before the DMA takes the USART
+  HC05_Baud();
+
+#if BOARD_HC05_FLOW
+  // ? the module holds CTS while its radio is behind, the DMA waits instead of overrunning it
+  HC05_SetFlowControl(app.hc05.device, True);
+#endif
+
+  // ? one DMA transfer per contiguous region instead of one TXE interrupt per byte
+  if (HC05_AttachTx(app.hc05.device, app.hc05.tx) != Success)
+    return Fail;
+
+  // ? circular DMA, no interrupt per byte: the idle line marks the end of a frame
+  // ? data mode from here on: no AT command, the link carries telemetry & the shell only
+  return HC05_AttachRx(app.hc05.device, 128);
+}
+
+static task_t HC05_Baud(void)
+{
+  volatile uint32_t baud = 0;
+
+  // ? button held at power-up: the module was powered with KEY high (full AT mode), set its data rate
+  if (app.button.device && !Button_isFree(app.button.device) && HC05_SetModuleBaud(app.hc05.device, HC05_LINK_BAUD, HC05_TIMEOUT) == Success)
+  {
+    baud = HC05_LINK_BAUD;
+
+    return app.storage.device ? Storage_Write(app.storage.device, STORAGE_KEY_HC05_BAUD, (const uint8_t *)&baud, sizeof(baud)) : Success;
+  }
+
+  // ? data mode: no AT at all, every byte reaches the host, take the rate of the last setup
+  if (app.storage.device && Storage_Read(app.storage.device, STORAGE_KEY_HC05_BAUD, (uint8_t *)&baud, sizeof(baud)) == Success)
+    return HC05_SetBaud(app.hc05.device, baud);
+
   return Success;
 }
 
 static task_t HC05_Printf(const uint8_t str[], size_t len)
 {
-  app.schedule |= HC05_BUSY;
+  // ? text must not be lost between telemetry frames, wait for room up to a deadline
+  return HC05_SendWith(app.hc05.device, str, len, HC05_BLOCK, HC05_TX_TIMEOUT);
+}
+
+static task_t HC05_Task(void)
+{
+  uint8_t bytes[16] = {0};
+  size_t len = 0;
 
-  Buffer_Flush(app.hc05.tx);
-  Buffer_Flush(app.hc05.rx);
+  // ? a broken frame is dropped as a whole
+  if (HC05_TakeOverrun(app.hc05.device))
+  {
+    Buffer_Flush(app.hc05.rx);
+    app.hc05.isFrame = False;
+  }
+
+  while ((len = HC05_Receive(app.hc05.device, bytes, sizeof(bytes))) != 0)
+  {
+    // ? the next frame replaces the one nobody took
+    if (app.hc05.isFrame)
+    {
+      Buffer_Flush(app.hc05.rx);
+      app.hc05.isFrame = False;
+    }
 
-  for (size_t i = 0; i < len; ++i)
-    Buffer_Push(app.hc05.tx, str[i]);
+    for (size_t i = 0; i < len; ++i)
+      Buffer_Push(app.hc05.rx, bytes[i]);
+  }
+
+  if (HC05_TakeFrame(app.hc05.device) && Buffer_Length(app.hc05.rx) != 0)
+    app.hc05.isFrame = True;
 
-  // ? clear residual data
-  uint8_t temp = app.hc05.device->USARTx->DR;
-  (void)temp;
+  return app.hc05.isFrame ? Success : Fail;
+}
 
-  // app.hc05.device->USARTx->CR1 |= _BIT(5); // enable RXNEIE
-  app.hc05.device->USARTx->CR1 |= _BIT(7); // enable TXEIE
+// ? Telemetry ----------------------------------------------------------------------------------
+static task_t Telemetry_Init(void)
+{
+  app.telemetry.device = Telemetry_Constructor();
+  app.telemetry.attitude = Telemetry_Stream_Constructor(3, TELEMETRY_ATTITUDE_KEY);
+  app.telemetry.distance = Telemetry_Stream_Constructor(3, TELEMETRY_DISTANCE_KEY);
+
+  if (!app.telemetry.device)
+    return Fail;
+  if (!app.telemetry.attitude)
+    return Fail;
+  if (!app.telemetry.distance)
+    return Fail;
 
   return Success;
 }
 
+static task_t Telemetry_Send(Telemetry_Stream_DS *const stream, uint8_t type, const sint32_t values[], HC05_Policy_Enum policy, uint32_t timeout)
+{
+  if (!app.telemetry.device || !stream)
+    return Fail;
+
+  // ? muted from the shell, e.g. to read its answers in a terminal
+  if (!app.telemetry.isStreaming)
+    return Success;
+
+  // ? successive samples differ a little, deltas mostly take 1 byte per channel
+  if (Telemetry_Stream_Encode(stream, app.telemetry.device, type, values) != Success)
+    return Fail;
+
+  const task_t room = HC05_Reserve(app.hc05.device, Telemetry_Size(app.telemetry.device), policy, timeout);
+
+  // ? older frames were removed for this one, deltas of both streams lost their reference
+  if (HC05_GetDropped(app.hc05.device) != app.telemetry.evicted)
+  {
+    app.telemetry.evicted = HC05_GetDropped(app.hc05.device);
+    Telemetry_Stream_Reset(app.telemetry.attitude);
+    Telemetry_Stream_Reset(app.telemetry.distance);
+
+    // ? encoded again as a keyframe, Telemetry_End() checks its larger size
+    if (Telemetry_Stream_Encode(stream, app.telemetry.device, type, values) != Success)
+      return Fail;
+  }
+
+  // ? no room: the frame is dropped, the host sees the gap in the sequence & waits for a keyframe
+  if (room != Success || Telemetry_End(app.telemetry.device, app.hc05.tx) != Success)
+  {
+    Telemetry_Stream_Reset(stream);
+    app.telemetry.dropped++;
+    return Fail;
+  }
+
+  app.telemetry.sent++;
+
+  return HC05_Transmit(app.hc05.device);
+}
+
+// ? Shell --------------------------------------------------------------------------------------
+static task_t Shell_Init(void)
+{
+  // ? first match wins, one line each: "rate imu 833", "tof budget 20", "stats", "stream on"
+  static const Shell_Command_t commandTable[] = {
+      {.name = "rate imu", .usage = "<13|26|52|104|208|416|833|1660>", .minArgs = 1, .maxArgs = 1, .handler = Shell_Rate},
+      {.name = "tof budget", .usage = "<20|33|50|100|200|500>", .minArgs = 1, .maxArgs = 1, .handler = Shell_Budget},
+      {.name = "stats", .usage = "", .minArgs = 0, .maxArgs = 0, .handler = Shell_Stats},
+      {.name = "stream", .usage = "<on|off>", .minArgs = 1, .maxArgs = 1, .handler = Shell_Stream}};
+
+  app.shell.device = Shell_Constructor(commandTable, sizeof(commandTable) / sizeof(commandTable[0]), Shell_Output, 0);
+
+  return app.shell.device ? Success : Fail;
+}
+
+static task_t Shell_Task(void)
+{
+  if (!app.hc05.isFrame)
+    return Fail;
+
+  uint8_t bytes[16] = {0};
+  size_t len = 0;
+  volatile uint8_t byte = 0;
+
+  // ? a line may come in several frames, the shell keeps the part before its end
+  while (Buffer_Take(app.hc05.rx, &byte) == Success)
+  {
+    bytes[len++] = byte;
+
+    if (len == sizeof(bytes))
+    {
+      if (app.shell.device)
+        Shell_Feed(app.shell.device, bytes, len);
+      len = 0;
+    }
+  }
+
+  app.hc05.isFrame = False;
+
+  if (!app.shell.device)
+    return Fail;
+
+  return Shell_Feed(app.shell.device, bytes, len);
+}
+
+static void Shell_Output(const uint8_t str[], size_t len, void *context)
+{
+  (void)context;
+
+  HC05_Printf(str, len);
+}
+
+static void Shell_Value(const char *label, uint32_t value, const char *unit)
+{
+  uint8_t str[FORMAT_MAX_TEXT];
+  size_t len = 0;
+
+  while (label[len])
+    len++;
+
+  HC05_Printf((const uint8_t *)label, len);
+  HC05_Printf(str, Format_Unsigned(str, sizeof(str), value, 0, ' '));
+
+  len = 0;
+  while (unit[len])
+    len++;
+
+  HC05_Printf((const uint8_t *)unit, len);
+}
+
+static task_t Shell_Rate(const Shell_Token_t args[], size_t argc, void *context)
+{
+  (void)argc;
+  (void)context;
+
+  static const struct
+  {
+    uint16_t hz;
+    LSM6DS3_ODR_Enum odr;
+  } rateTable[] = {{13, ODR_12Hz5}, {26, ODR_26Hz}, {52, ODR_52Hz}, {104, ODR_104Hz}, {208, ODR_208Hz}, {416, ODR_416Hz}, {833, ODR_833Hz}, {1660, ODR_1k66Hz}};
+
+  uint32_t hz = 0;
+
+  if (Shell_Unsigned(&args[0], &hz) != Success)
+    return Fail;
+
+  // ? raw belongs to DMA until the drain is decoded, its patterns are spaced by the old rate
+  if (app.lsm6ds3.isDraining || app.lsm6ds3.isDrained)
+    return Fail;
+
+  for (size_t i = 0; i < sizeof(rateTable) / sizeof(rateTable[0]); ++i)
+  {
+    if (rateTable[i].hz != hz)
+      continue;
+
+    LSM6DS3_Config_t config = app.lsm6ds3.config;
+    LSM6DS3_FIFOConfig_t fifo = app.lsm6ds3.fifo;
+
+    config.acce.odr = config.gyro.odr = fifo.odr = rateTable[i].odr;
+
+    if (LSM6DS3_Configure(app.lsm6ds3.device, &config, 1000) != Success)
+      return Fail;
+
+    // ? the FIFO is flushed, the next watermark holds patterns of the new rate only
+    if (LSM6DS3_SetFIFO(app.lsm6ds3.device, &fifo, 1000) != Success)
+      return Fail;
+
+    app.lsm6ds3.config = config;
+    app.lsm6ds3.fifo = fifo;
+    app.lsm6ds3.ticks = (LSM6DS3_FIFO_TICKS << ODR_416Hz) >> fifo.odr;
+
+    return Success;
+  }
+
+  return Fail;
+}
+
+static task_t Shell_Budget(const Shell_Token_t args[], size_t argc, void *context)
+{
+  (void)argc;
+  (void)context;
+
+  uint32_t ms = 0;
+
+  if (Shell_Unsigned(&args[0], &ms) != Success || ms > 0xFFFF)
+    return Fail;
+
+  // ? the timing registers are only taken while the ranging is stopped
+  if (app.gate.isRanging && VL53L1X_StopRanging(app.vl53l1x.device) != Success)
+    return Fail;
+
+  const task_t status = VL53L1X_SetTimingBudget(app.vl53l1x.device, (uint16_t)ms);
+
+  if (status == Success)
+    app.vl53l1x.budget = ms * 1000;
+
+  // ? resumed with the old budget on failure
+  if (app.gate.isRanging && VL53L1X_StartRanging(app.vl53l1x.device) != Success)
+    return Fail;
+
+  return status;
+}
+
+static task_t Shell_Stats(const Shell_Token_t args[], size_t argc, void *context)
+{
+  (void)args;
+  (void)argc;
+  (void)context;
+
+  const uint32_t imu = 40000 / app.lsm6ds3.ticks; // 25 us per tick
+
+  Shell_Value("uptime ", app.tick, " ms\r\n");
+  Shell_Value("imu ", imu, " Hz\r\n");
+  Shell_Value("tof ", app.vl53l1x.budget / 1000, app.gate.isRanging ? " ms, ranging\r\n" : " ms, suspended\r\n");
+  Shell_Value("hc05 ", HC05_GetBaud(app.hc05.device), " bps\r\n");
+  Shell_Value("telemetry sent ", app.telemetry.sent, app.telemetry.isStreaming ? ", streaming\r\n" : ", muted\r\n");
+  Shell_Value("telemetry dropped ", app.telemetry.dropped, "\r\n");
+  Shell_Value("hc05 dropped ", HC05_GetDropped(app.hc05.device), "\r\n");
+
+  return Success;
+}
+
+static task_t Shell_Stream(const Shell_Token_t args[], size_t argc, void *context)
+{
+  (void)argc;
+  (void)context;
+
+  if (Shell_isWord(&args[0], "off"))
+  {
+    app.telemetry.isStreaming = False;
+    return Success;
+  }
+
+  if (!Shell_isWord(&args[0], "on"))
+    return Fail;
+
+  // ? the host decoder lost track while muted, start over with keyframes
+  if (app.telemetry.attitude)
+    Telemetry_Stream_Reset(app.telemetry.attitude);
+  if (app.telemetry.distance)
+    Telemetry_Stream_Reset(app.telemetry.distance);
+
+  app.telemetry.isStreaming = True;
+
+  return Success;
+}
+
+// ? Storage ------------------------------------------------------------------------------------
+static task_t Storage_Init(void)
+{
+  app.storage.device = Storage_Constructor(STORAGE_PAGE_A, STORAGE_PAGE_B);
+
+  return app.storage.device ? Success : Fail;
+}
+
 // ? LSM6DS3 ------------------------------------------------------------------------------------
 static task_t LSM6DS3_Init(void)
 {
   const port_t CS = {.GPIOx = SCS_GPIO_Port, .order = 4};
   app.lsm6ds3.device = LSM6DS3_Constructor(SPI1, &CS); // pin order is 4 -> GPIOA pin 4
   app.lsm6ds3.buffer = Buffer_Constructor(6);
+  app.spi.bus = SPIBus_Constructor(SPI1, 4);
 
   if (!app.lsm6ds3.device)
     return Fail;
   if (!app.lsm6ds3.buffer)
     return Fail;
+  if (!app.spi.bus)
+    return Fail;
 
   LL_SPI_Enable(SPI1);
   LL_mDelay(200);
 
-  return LSM6DS3_DefaultInit(app.lsm6ds3.device);
+  if (LSM6DS3_AttachBus(app.lsm6ds3.device, app.spi.bus) != Success)
+    return Fail;
+
+  if (LSM6DS3_DefaultInit(app.lsm6ds3.device) != Success)
+    return Fail;
+
+  const LSM6DS3_Config_t config = {
+      .acce = {.odr = ODR_416Hz, .scale = XL_FS_2G, .bandwidth = XL_BW_ODR, .filter = XL_FILTER_OFF, .cutoff = 0, .power = POWER_HIGH_PERFORMANCE},
+      .gyro = {.odr = ODR_416Hz, .scale = G_FS_500DPS, .isHPF = False, .cutoff = 0, .power = POWER_HIGH_PERFORMANCE}};
+
+  if (LSM6DS3_Configure(app.lsm6ds3.device, &config, 1000) != Success)
+    return Fail;
+
+  app.lsm6ds3.config = config;
+
+  // ? uncalibrated readings are still usable, go on anyway
+  LSM6DS3_Calibration();
+
+  const Fusion_Config_t filter = {
+      .gyroScale = 17500, // +-500 dps
+      .kp = 2 * FUSION_ONE_Q16,
+      .ki = FUSION_ONE_Q16 / 20};
+
+  app.fusion.device = Fusion_Constructor(&filter);
+
+  if (!app.fusion.device)
+    return Fail;
+
+  const LSM6DS3_FIFOConfig_t fifo = {
+      .odr = ODR_416Hz,
+      .gyro = DEC_1,
+      .acce = DEC_1,
+      .watermark = LSM6DS3_FIFO_SAMPLES * 6,
+      .mode = FIFO_CONTINUOUS};
+
+  if (LSM6DS3_SetFIFO(app.lsm6ds3.device, &fifo, 1000) != Success)
+    return Fail;
+
+  app.lsm6ds3.fifo = fifo;
+  app.lsm6ds3.ticks = LSM6DS3_FIFO_TICKS;
+
+  // ? 62.5 mg wake-up & 560 mg single tap at +-2 g, latched until they are read
+  const LSM6DS3_MotionConfig_t motion = {
+      .wakeUp = {.threshold = 2, .duration = 0},
+      .tap = {.axes = AXIS_X | AXIS_Y | AXIS_Z, .threshold = 9, .shock = 2, .quiet = 1, .gap = 0, .isDouble = False},
+      .freeFall = {.threshold = 3, .duration = 6},
+      .isSignificantMotion = False,
+      .isLatched = True};
+
+  if (LSM6DS3_SetMotion(app.lsm6ds3.device, &motion, 1000) != Success)
+    return Fail;
+
+  // ? the FIFO runs on the clock of the device, its timestamp tells how fast
+  if (LSM6DS3_EnableTimestamp(app.lsm6ds3.device, 1000) != Success)
+    return Fail;
+
+  // ? INT1 is strapped to GND on the board, it is never driven high: open drain & active low
+  if (LSM6DS3_SetPinMode(app.lsm6ds3.device, True, True, 1000) != Success)
+    return Fail;
+
+#if BOARD_IMU_INT
+  const port_t INT1 = {.GPIOx = INT1_GPIO_Port, .order = 0};
+  const port_t INT2 = {.GPIOx = INT2_GPIO_Port, .order = 1};
+
+  // ? watermark on INT1 for the drain, wake-up & tap on INT2 for the ranging
+  if (LSM6DS3_SetInterrupt(app.lsm6ds3.device, LSM6DS3_INT1, INT_FIFO_TH, 1000) != Success)
+    return Fail;
+  if (LSM6DS3_SetInterrupt(app.lsm6ds3.device, LSM6DS3_INT2, 0, 1000) != Success)
+    return Fail;
+  if (LSM6DS3_RouteMotion(app.lsm6ds3.device, LSM6DS3_INT2, EVENT_WAKE_UP | EVENT_SINGLE_TAP, 1000) != Success)
+    return Fail;
+
+  if (LSM6DS3_BindInterrupt(app.lsm6ds3.device, LSM6DS3_INT1, &INT1) != Success)
+    return Fail;
+
+  return LSM6DS3_BindInterrupt(app.lsm6ds3.device, LSM6DS3_INT2, &INT2);
+#else
+  // ? nothing routed, the watermark & the motion sources are polled
+  return Success;
+#endif
 }
 
-static task_t LSM6DS3_Task(void)
+static task_t LSM6DS3_Calibration(void)
 {
-  app.schedule |= LSM6DS3_BUSY;
-  app.schedule &= LSM6DS3_WAIT;
+  LSM6DS3_Bias_t bias = {0};
 
-  uint8_t value = 0, raw[2] = {0}, str[5] = {0};
-  sint16_t sdata = 0;
-  uint16_t udata = 0;
+  // ? bias of the last boot, calibrate again if none or the full-scale is changed
+  if (app.storage.device && Storage_Read(app.storage.device, STORAGE_KEY_IMU_BIAS, (uint8_t *)&bias, sizeof(bias)) == Success)
+    if (LSM6DS3_SetBias(app.lsm6ds3.device, &bias, 1000) == Success)
+      return Success;
 
-  if (LSM6DS3_getRegister(app.lsm6ds3.device, STATUS_R, &value, 1000) != Success)
+  // ? the board lies flat & still, Z up
+  const sint8_t gravity[3] = {0, 0, 1};
+
+  if (LSM6DS3_Calibrate(app.lsm6ds3.device, gravity, LSM6DS3_CAL_SAMPLES, LSM6DS3_CAL_STILL, &bias, 1000) != Success)
     return Fail;
 
-  if (!_MASK(value, _BIT(0)))
+  if (!app.storage.device)
     return Fail;
 
-  if (LSM6DS3_getRegister(app.lsm6ds3.device, ACCE_Z_L, &raw[0], 1000) != Success)
+  return Storage_Write(app.storage.device, STORAGE_KEY_IMU_BIAS, (const uint8_t *)&bias, sizeof(bias));
+}
+
+static task_t LSM6DS3_Task(void)
+{
+  app.schedule |= LSM6DS3_BUSY;
+  app.schedule &= LSM6DS3_WAIT;
+
+  // ? raw belongs to DMA until the drain is done
+  if (app.lsm6ds3.isDraining)
     return Fail;
 
-  if (LSM6DS3_getRegister(app.lsm6ds3.device, ACCE_Z_H, &raw[1], 1000) != Success)
+  if (!app.lsm6ds3.isDrained)
+  {
+#if BOARD_IMU_INT
+    // ? no SPI access until the watermark edge is seen
+    if (!LSM6DS3_TakeInterrupt(app.lsm6ds3.device, LSM6DS3_INT1, &app.lsm6ds3.timestamp))
+      return Fail;
+#else
+    // ? one FIFO_STATUS2 read per tick, the watermark is seen within a tick
+    if (!LSM6DS3_isFIFOWatermark(app.lsm6ds3.device))
+      return Fail;
+
+    app.lsm6ds3.timestamp = Timebase_Now();
+#endif
+
+    // ? set before submit, the drain may finish before it returns
+    app.lsm6ds3.isDraining = True;
+    if (LSM6DS3_DrainFIFOAsync(app.lsm6ds3.device, app.lsm6ds3.raw, LSM6DS3_FIFO_RAW, LSM6DS3_Drained, 0) != Success)
+      app.lsm6ds3.isDraining = False;
+
     return Fail;
+  }
 
-  sdata = (sint16_t)((raw[1] << 8) | raw[0]);
-  udata = (sdata < 0) ? (-sdata) : (+sdata);
+  app.lsm6ds3.isDrained = False;
 
-  str[0] = (sdata < 0) ? '-' : '+';
+  // ? the timestamp is read between two local times, its middle is taken as the moment of the read
+  volatile uint32_t ticks = 0;
+  const uint32_t before = Timebase_Now();
 
-  udata /= 163;
-  str[4] = '0' + (udata % 10);
+  if (LSM6DS3_GetTimestamp(app.lsm6ds3.device, &ticks, 1000) == Success)
+  {
+    const uint32_t after = Timebase_Now();
+    Timebase_Clock_Observe(app.timebase.imu, ticks, before + (after - before) / 2);
+  }
 
-  udata /= 10;
-  str[3] = '0' + (udata % 10);
+  // ? pattern period on the local clock, the device oscillator drifts from the nominal 416 Hz
+  const uint32_t period = Timebase_Clock_Scale(app.timebase.imu, app.lsm6ds3.ticks);
 
-  str[2] = '.';
+  if (LSM6DS3_DecodeFIFO(app.lsm6ds3.device, app.lsm6ds3.raw, app.lsm6ds3.samples, LSM6DS3_FIFO_SAMPLES, &app.lsm6ds3.count) != Success)
+    return Fail;
 
-  udata /= 10;
-  str[1] = '0' + (udata % 10);
+  if (app.lsm6ds3.count == 0)
+    return Fail;
 
-  while (_MASK(app.schedule, HC05_BUSY))
+  for (size_t i = 0; i < app.lsm6ds3.count; ++i)
   {
+    const LSM6DS3_Sample_t *const sample = &app.lsm6ds3.samples[i];
+    q15_t gravity[3] = {0};
+
+    // ? the watermark edge is taken as the time of the last pattern
+    const uint32_t timestamp = app.lsm6ds3.timestamp - (app.lsm6ds3.count - 1 - i) * period;
+
+    Fusion_Update(app.fusion.device, sample->gyro, sample->acce, period);
+    Fusion_GetGravity(app.fusion.device, gravity);
+    TiltRange_Push(app.tilt.device, timestamp, gravity, sample->gyro);
   }
+
+  // ? slow turns stay below the wake-up threshold, the gyro still sees them
+  RangeGate_Inertial(app.gate.device, app.tick, app.lsm6ds3.samples[0].gyro, sizeof(LSM6DS3_Sample_t) / sizeof(sint16_t), app.lsm6ds3.count);
+
+  Fusion_GetEuler(app.fusion.device, &app.fusion.roll, &app.fusion.pitch);
+
   app.schedule &= ~LSM6DS3_BUSY;
-  return HC05_Printf(str, 5);
+
+  // ? time of the latest pattern, on the same timebase as the distance
+  const sint32_t attitude[3] = {app.fusion.roll, app.fusion.pitch, (sint32_t)app.lsm6ds3.timestamp};
+
+  // ? many per second, only the latest matters: older frames not yet started make room
+  return Telemetry_Send(app.telemetry.attitude, TELEMETRY_ATTITUDE, attitude, HC05_DROP_OLDEST, 0);
+}
+
+static void LSM6DS3_Drained(task_t result, void *context)
+{
+  (void)context;
+
+  // ! called from DMA1 IT
+  app.lsm6ds3.isDrained = (result == Success) ? True : False;
+  app.lsm6ds3.isDraining = False;
+}
+
+static task_t Motion_Task(void)
+{
+#if BOARD_IMU_INT
+  // ? no SPI access until the motion edge is seen
+  if (!LSM6DS3_TakeInterrupt(app.lsm6ds3.device, LSM6DS3_INT2, 0))
+    return Fail;
+#else
+  // ? the loop also wakes up for the display & DMA, read the latched sources once per tick
+  if (app.motion.polled == app.tick)
+    return Fail;
+
+  app.motion.polled = app.tick;
+#endif
+
+  if (LSM6DS3_GetMotion(app.lsm6ds3.device, &app.motion.events, 1000) != Success)
+    return Fail;
+
+  if (_MASK(app.motion.events, EVENT_WAKE_UP | EVENT_SINGLE_TAP))
+    RangeGate_Motion(app.gate.device, app.tick);
+
+  return Success;
 }
 
 // ? VL53L1X ------------------------------------------------------------------------------------
 static task_t VL53L1X_Init(void)
 {
+  // ? IMU frame: Z up when the board lies flat (as calibrated), the ToF looks out along +X
+  const TiltRange_Config_t tilt = {
+      .axis = {32767, 0, 0},
+      .maxRate = TILT_MAX_RATE,
+      .maxSkew = TILT_MAX_SKEW};
+
+  const RangeGate_Config_t gate = {
+      .stillTime = GATE_STILL,
+      .band = GATE_BAND,
+      .window = GATE_WINDOW,
+      .variance = GATE_VARIANCE};
+
   app.vl53l1x.device = VL53L1X_Constructor(I2C1, 0x52);
+  app.tilt.device = TiltRange_Constructor(&tilt, TILT_HISTORY);
+  app.gate.device = RangeGate_Constructor(&gate, app.tick);
 
   if (!app.vl53l1x.device)
     return Fail;
+  if (!app.tilt.device)
+    return Fail;
+  if (!app.gate.device)
+    return Fail;
 
   LL_I2C_Enable(I2C1);
   LL_mDelay(200);
 
-  return VL53L1X_DefaultInit(app.vl53l1x.device);
+  // ? ranging starts with the default init
+  if (VL53L1X_DefaultInit(app.vl53l1x.device) != Success)
+    return Fail;
+
+#if BOARD_TOF_INT
+  // ? GPIO1 marks the end of each ranging, its edge is the timestamp of the distance
+  const port_t GPIO1 = {.GPIOx = TOF_INT_GPIO_Port, .order = 2};
+
+  if (VL53L1X_BindInterrupt(app.vl53l1x.device, &GPIO1) != Success)
+    return Fail;
+#endif
+
+  app.gate.isRanging = True;
+  app.vl53l1x.budget = VL53L1X_BUDGET;
+
+  return Success;
 }
 
 static task_t VL53L1X_Task(void)
@@ -225,28 +889,89 @@ static task_t VL53L1X_Task(void)
   app.schedule |= VL53L1X_BUSY;
   app.schedule &= VL53L1X_WAIT;
 
-  while (!VL53L1X_isDataReady(app.vl53l1x.device))
+#if BOARD_TOF_INT
+  // ? no I2C access until the data ready edge is seen
+  if (!VL53L1X_TakeInterrupt(app.vl53l1x.device, &app.vl53l1x.timestamp))
   {
+    status = Fail;
+    goto __END;
   }
+#else
+  // ? GPIO1 is not wired on the board, poll the status once per tick
+  if (!VL53L1X_isDataReady(app.vl53l1x.device))
+  {
+    status = Fail;
+    goto __END;
+  }
+
+  app.vl53l1x.timestamp = Timebase_Now();
+#endif
 
   status = VL53L1X_GetDistance(app.vl53l1x.device, &app.vl53l1x.distance);
   if (status != Success)
     goto __END;
 
-  app.vl53l1x.distance /= 10;
-  app.display.number[0] = app.vl53l1x.distance % 10;
+  // ? release GPIO1 & the data ready status, or the next ranging is never seen
+  status = VL53L1X_ClearInterrupt(app.vl53l1x.device);
+  if (status != Success)
+    goto __END;
+
+  // ? align with the attitude in the middle of the ranging window
+  if (TiltRange_Measure(app.tilt.device, app.vl53l1x.timestamp - app.vl53l1x.budget / 2, app.vl53l1x.budget / 2, app.vl53l1x.distance, &app.tilt.result) == Success && app.tilt.result.isAligned)
+  {
+    // ? keep the last reading while the device is turning fast
+    if (app.tilt.result.isMoving)
+      goto __END;
+
+    app.tilt.horizontal = app.tilt.result.horizontal;
+  }
+  else
+    app.tilt.horizontal = app.vl53l1x.distance;
+
+  // ? the gate watches the raw reading of the sensor
+  RangeGate_Distance(app.gate.device, app.vl53l1x.distance);
+
+  const sint32_t distance[3] = {app.vl53l1x.distance, (sint32_t)app.vl53l1x.timestamp, app.tilt.horizontal};
 
-  app.vl53l1x.distance /= 10;
-  app.display.number[1] = app.vl53l1x.distance % 10;
+  // ? one per timing budget, worth a short wait for the DMA
+  Telemetry_Send(app.telemetry.distance, TELEMETRY_DISTANCE, distance, HC05_BLOCK, TELEMETRY_DISTANCE_WAIT);
 
-  app.vl53l1x.distance /= 10;
-  app.display.number[2] = app.vl53l1x.distance % 10;
+  // ? mm -> cm, lowest digit on the right, the point after the meters
+  if (app.display.device)
+  {
+    Display_Unsigned(app.display.device, Format_Div10(app.tilt.horizontal, 0), 2);
+    Display_Show(app.display.device);
+  }
 
 __END:
   app.schedule &= ~VL53L1X_BUSY;
   return status;
 }
 
+static task_t Gate_Task(void)
+{
+  const bool_t isActive = RangeGate_Update(app.gate.device, app.tick);
+
+  if (isActive == app.gate.isRanging)
+    return Success;
+
+  // ? resume at once on motion, stop the ToF & its I2C traffic while still
+  if (isActive)
+  {
+    if (VL53L1X_StartRanging(app.vl53l1x.device) != Success)
+      return Fail;
+  }
+  else
+  {
+    if (VL53L1X_StopRanging(app.vl53l1x.device) != Success)
+      return Fail;
+  }
+
+  app.gate.isRanging = isActive;
+
+  return Success;
+}
+
 // ? Seven Segment ------------------------------------------------------------------------------
 static task_t SevenSegment_Init(void)
 {
@@ -265,13 +990,10 @@ static task_t SevenSegment_Init(void)
       [6] = {.GPIOx = SSG_GPIO_Port, .order = 9},
       [7] = {.GPIOx = SSP_GPIO_Port, .order = 10}};
 
-  for (size_t i = 0; i < 3; ++i)
-  {
-    app.display.device[i] = SevenSegment_Constructor(&commonTable[i], ioTable);
+  app.display.device = Display_Constructor(commonTable, 3, ioTable);
 
-    if (!app.display.device[i])
-      return Fail;
-  }
+  if (!app.display.device)
+    return Fail;
 
   TIM4->DIER |= _BIT(0); // enable UIE
   TIM4->CR1 |= _BIT(0);  // enable CEN
@@ -301,12 +1023,57 @@ task_t APP_Init(void)
 {
   // reset flag
   app.schedule = Nothing;
+  app.tick = 0;
+
+  app.motion.events = 0;
+  app.motion.polled = 0;
+  app.hc05.isFrame = False;
+  app.gate.isRanging = False;
+  app.telemetry.isStreaming = True;
+  app.telemetry.sent = app.telemetry.dropped = 0;
+  app.lsm6ds3.ticks = LSM6DS3_FIFO_TICKS;
+  app.vl53l1x.budget = VL53L1X_BUDGET;
+
+  // ? first of all, every edge & sample is stamped by it
+  Timebase_Init();
+
+  // ? before hc05, its link rate is saved in it
+  const task_t storage = Storage_Init();
+
+  // ? before hc05, held at power-up it starts the AT setup of the link rate
+  const task_t button = Button_Init();
 
   // hc05
   if (HC05_Init() == Success)
-    HC05_Printf((uint8_t *)"hc05 init done.\r\n", 17);
+  {
+    uint8_t line[40] = "hc05 init done, "; // ? up to 10 digits & " bps.\r\n"
+    size_t len = 16;
+
+    len += Format_Unsigned(&line[len], sizeof(line) - len, HC05_GetBaud(app.hc05.device), 0, ' ');
+    line[len++] = ' ';
+    line[len++] = 'b';
+    line[len++] = 'p';
+    line[len++] = 's';
+    line[len++] = '.';
+    line[len++] = '\r';
+    line[len++] = '\n';
+
+    HC05_Printf(line, len);
+  }
   // else return _ERROR();
 
+  // telemetry
+  if (Telemetry_Init() == Success)
+    HC05_Printf((uint8_t *)"telemetry init done.\r\n", 22);
+  else
+    HC05_Printf((uint8_t *)"telemetry init fail.\r\n", 22);
+
+  // storage
+  if (storage == Success)
+    HC05_Printf((uint8_t *)"storage init done.\r\n", 20);
+  else
+    HC05_Printf((uint8_t *)"storage init fail.\r\n", 20);
+
   // lsm6ds3
   if (LSM6DS3_Init() == Success)
     HC05_Printf((uint8_t *)"lsm6ds3 init done.\r\n", 20);
@@ -320,7 +1087,7 @@ task_t APP_Init(void)
     HC05_Printf((uint8_t *)"vl53v1x init fail.\r\n", 20);
 
   // button
-  if (Button_Init() == Success)
+  if (button == Success)
     HC05_Printf((uint8_t *)"button init done.\r\n", 19);
   else
     HC05_Printf((uint8_t *)"button init fail.\r\n", 19);
@@ -331,6 +1098,12 @@ task_t APP_Init(void)
   else
     HC05_Printf((uint8_t *)"display init fail.\r\n", 20);
 
+  // shell
+  if (Shell_Init() == Success)
+    HC05_Printf((uint8_t *)"shell init done.\r\n", 18);
+  else
+    HC05_Printf((uint8_t *)"shell init fail.\r\n", 18);
+
   // enable systick interrupt
   SysTick->CTRL =
       SysTick_CTRL_ENABLE_Msk | // Enable SysTick Timer
@@ -346,14 +1119,23 @@ task_t APP_Task(void)
   {
   }
 
+  Motion_Task();
+
+  // ? a frame from the host is a command line
+  if (HC05_Task() == Success)
+    Shell_Task();
+
   // check if any module is busy
   if (_MASK(app.schedule, 0xF0))
     return Success;
 
+  Gate_Task();
+
   if (app.button.isToggled && Button_isFree(app.button.device))
   {
 
-    if (_MASK(app.schedule, VL53L1X_WAIT))
+    // ? a stopped ToF never gets ready
+    if (_MASK(app.schedule, VL53L1X_WAIT) && app.gate.isRanging)
       VL53L1X_Task();
 
     if (_MASK(app.schedule, LSM6DS3_WAIT))
@@ -362,19 +1144,25 @@ task_t APP_Task(void)
     app.button.isToggled = False;
   }
 
+  // ? sleep until the next interrupt: SysTick, EXTI (FIFO / motion) or DMA
+  __WFI();
+
   return Success;
 }
 
 // ? SysTick IT ----------------------------------------------------------------------------------
 void APP_SysTick_Handler(void)
 {
-  if (_MASK(app.schedule, HC05_BUSY))
-    return;
+  app.tick++;
+
+  if (app.timebase.device)
+    Timebase_Tick(app.timebase.device);
 
   if (!_MASK(app.schedule, LSM6DS3_BUSY))
     app.schedule |= LSM6DS3_WAIT;
 
-  if (!_MASK(app.schedule, VL53L1X_BUSY))
+  // ? no ranging while the gate is closed
+  if (!_MASK(app.schedule, VL53L1X_BUSY) && app.gate.isRanging)
     app.schedule |= VL53L1X_WAIT;
 
   if (!app.button.isToggled && !Button_isFree(app.button.device))
@@ -384,54 +1172,55 @@ void APP_SysTick_Handler(void)
 // ? TIM4 IT ------------------------------------------------------------------------------------
 void APP_TIM4_IRQHandler(void)
 {
-  static uint8_t index = 0;
-  static const flag8_t segmentTable[] = {Num0, Num1, Num2, Num3, Num4, Num5, Num6, Num7, Num8, Num9};
-
   if (_MASK(TIM4->SR, _BIT(0)))
   {
     TIM4->SR &= ~_BIT(0);
 
-    SevenSegment_Reset(app.display.device[index]);
+    Display_Scan(app.display.device);
+  }
+}
 
-    index = (index + 1) % 3;
+// ? USART1 IT ----------------------------------------------------------------------------------
+void APP_USART1_IRQHandler(void)
+{
+  HC05_RxIRQHandler(app.hc05.device); // IDLE, TX & RX go through DMA1 channel 4 & 5
+}
 
-    flag8_t segment = segmentTable[app.display.number[index]];
+// ? DMA1 IT ------------------------------------------------------------------------------------
+void APP_DMA1_Channel2_IRQHandler(void)
+{
+  SPIBus_IRQHandler(app.spi.bus); // SPI1 RX
+}
 
-    if (index == 2)
-      segment |= SegP;
+void APP_DMA1_Channel3_IRQHandler(void)
+{
+  SPIBus_IRQHandler(app.spi.bus); // SPI1 TX
+}
 
-    SevenSegment_Set(app.display.device[index], segment);
-  }
+void APP_DMA1_Channel4_IRQHandler(void)
+{
+  HC05_TxIRQHandler(app.hc05.device); // USART1 TX
 }
 
-// ? USART1 IT ----------------------------------------------------------------------------------
-void APP_USART1_IRQHandler(void)
+void APP_DMA1_Channel5_IRQHandler(void)
 {
-  const flag32_t flag = app.hc05.device->USARTx->SR;
+  HC05_RxIRQHandler(app.hc05.device); // USART1 RX
+}
 
-  volatile uint8_t byte = 0;
+// ? EXTI IT ------------------------------------------------------------------------------------
+void APP_EXTI0_IRQHandler(void)
+{
+  LSM6DS3_IRQHandler(app.lsm6ds3.device, Timebase_Now()); // LSM6DS3 INT1
+}
 
-  /*if (_MASK(flag, _BIT(5)))
-  { // RXNE
-    HC05_RxByte(app.hc05.device, &byte, 10);
-    Buffer_Push(app.hc05.rx, byte);
-    if (Buffer_isEndAs(app.hc05.rx, (uint8_t *)"OK\r\n", 4))
-    {
-      app.hc05.device->USARTx->CR1 &= ~_BIT(5);
-      // app.schedule &= ~HC05_BUSY;
-    }
-  }
-  else */
-  if (_MASK(flag, _BIT(7)))
-  { // TXE
-    if (Buffer_Length(app.hc05.tx) == 1)
-    {
-      app.hc05.device->USARTx->CR1 &= ~_BIT(7);
-      app.schedule &= ~HC05_BUSY;
-    }
-    Buffer_Take(app.hc05.tx, &byte);
-    HC05_TxByte(app.hc05.device, byte, 10);
-  }
+void APP_EXTI1_IRQHandler(void)
+{
+  LSM6DS3_IRQHandler(app.lsm6ds3.device, Timebase_Now()); // LSM6DS3 INT2
+}
+
+void APP_EXTI2_IRQHandler(void)
+{
+  VL53L1X_IRQHandler(app.vl53l1x.device, Timebase_Now()); // VL53L1X GPIO1
 }
 
 /* ---------------------------------------------------------------- Class Public Functions End */